@@ -0,0 +1,72 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "dijkstra.h"
+#include "generators.h"
+#include "gridDijkstra.h"
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+// Dijkstra on random graphs and weight grids. The Complexity estimate is varied, to see how much the size of the first
+// memory chunk matters compared to growing it on demand.
+
+namespace {
+
+template <std::size_t Complexity> void BM_dijkstra_graph(benchmark::State &state) {
+  auto const nodes = static_cast<uint32_t>(state.range(0));
+  auto const g = bench::randomGraph(nodes, 4, 100);
+  std::size_t expanded = 0;
+  for (auto _ : state) {
+    AoC::Dijkstra<bench::GraphNode, uint32_t, Complexity> d(bench::GraphNode{&g}, 0, AoC::DijkstraMode::EarlyExit);
+    benchmark::DoNotOptimize(d.solve().first);
+    expanded = d.stats().expanded;
+  }
+  state.counters["expanded"] = static_cast<double>(expanded);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * expanded));
+}
+
+template <std::size_t Complexity> void BM_dijkstra_grid(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    AoC::Dijkstra<bench::GridNode, uint32_t, Complexity> d(bench::GridNode{&grid}, 0, AoC::DijkstraMode::EarlyExit);
+    benchmark::DoNotOptimize(d.solve().first);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * side * side));
+}
+
+void BM_gridDijkstra(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    AoC::GridDijkstra d(grid, {0, 0}, {side - 1, side - 1});
+    benchmark::DoNotOptimize(d.solve());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * side * side));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_dijkstra_graph, 16)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_dijkstra_graph, 1024)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_dijkstra_graph, 65536)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_dijkstra_grid, 16)->Arg(100)->Arg(300);
+BENCHMARK_TEMPLATE(BM_dijkstra_grid, 1024)->Arg(100)->Arg(300);
+BENCHMARK_TEMPLATE(BM_dijkstra_grid, 65536)->Arg(100)->Arg(300);
+BENCHMARK(BM_gridDijkstra)->Arg(100)->Arg(300);
@@ -0,0 +1,95 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "generators.h"
+#include "nodeStore.h"
+#include "priorityQueue.h"
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// The node storage of Dijkstra: one polymorphic pool allocation per node with a pointer in the heap (the old way), against
+// the NodeStore with 32 bit handles. Both run the same push/pop pattern, that mimics a search on a grid.
+
+namespace {
+
+struct Payload {
+  const void *grid;
+  uint32_t x, y, costs;
+};
+
+// pop one node, push up to three successors with slightly higher costs, until `count` nodes were pushed
+template <typename Push, typename Pop, typename Empty> void churn(std::size_t count, Push push, Pop pop, Empty empty) {
+  bench::Lcg rnd;
+  push(0u, Payload{nullptr, 0, 0, 0});
+  std::size_t pushed = 1;
+  while (!empty() && pushed < count) {
+    auto [k, n] = pop();
+    for (uint32_t i = 0, e = 1 + rnd() % 3; i < e && pushed < count; ++i, ++pushed)
+      push(k + 1 + rnd() % 9, Payload{n.grid, n.x + i, n.y + 1, n.costs + i});
+  }
+}
+
+void BM_store_pmr(benchmark::State &state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::polymorphic_allocator<Payload> alloc{&pool};
+    AoC::BinaryHeapQueue<uint32_t, Payload *> heap;
+    churn(
+        count, [&](uint32_t k, Payload p) { heap.push(k, alloc.new_object<Payload>(p)); },
+        [&] {
+          auto [k, ptr] = heap.top();
+          heap.pop();
+          auto p = *ptr;
+          alloc.delete_object(ptr);
+          return std::pair{k, p};
+        },
+        [&] { return heap.empty(); });
+    benchmark::DoNotOptimize(heap.size());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+void BM_store_nodeStore(benchmark::State &state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    std::pmr::unsynchronized_pool_resource pool;
+    AoC::NodeStore<Payload> store{&pool};
+    AoC::BinaryHeapQueue<uint32_t, uint32_t> heap;
+    churn(
+        count, [&](uint32_t k, Payload p) { heap.push(k, store.emplace(p)); },
+        [&] {
+          auto [k, h] = heap.top();
+          heap.pop();
+          auto p = store[h];
+          store.erase(h);
+          return std::pair{k, p};
+        },
+        [&] { return heap.empty(); });
+    benchmark::DoNotOptimize(heap.size());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+} // namespace
+
+BENCHMARK(BM_store_pmr)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_store_nodeStore)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
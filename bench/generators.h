@@ -0,0 +1,145 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BENCH_GENERATORS_H
+#define BENCH_GENERATORS_H
+
+#include <numericGrid.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// synthetic inputs for the benchmarks, all of them are deterministic
+
+namespace bench {
+
+/**
+ * @brief small linear congruential generator, so the inputs do not depend on the standard library
+ */
+struct Lcg {
+  uint32_t seed = 42;
+  uint32_t operator()() {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+  }
+};
+
+/**
+ * @brief puzzle style input: `rows` lines of `columns` random digits
+ */
+inline std::string gridText(std::size_t rows, std::size_t columns, uint32_t seed = 42) {
+  Lcg rnd{seed};
+  std::string out;
+  out.reserve(rows * (columns + 1));
+  for (std::size_t y = 0; y < rows; ++y) {
+    for (std::size_t x = 0; x < columns; ++x)
+      out.push_back(static_cast<char>('0' + rnd() % 10));
+    out.push_back('\n');
+  }
+  return out;
+}
+
+/**
+ * @brief a grid with random weights from 1 to 9
+ */
+inline AoC::numericGrid<uint_fast8_t> weightGrid(std::size_t rows, std::size_t columns, uint32_t seed = 42) {
+  Lcg rnd{seed};
+  AoC::numericGrid<uint_fast8_t> grid{rows, columns};
+  for (auto &v : grid)
+    v = static_cast<uint_fast8_t>(1 + rnd() % 9);
+  return grid;
+}
+
+/**
+ * @brief random directed graph with weighted edges, stored as adjacency arrays
+ *
+ * Every node has `degree` edges to random nodes, and one edge to its successor, so the last node is reachable from the
+ * first one.
+ */
+struct WeightedGraph {
+  std::vector<uint32_t> offsets, targets, weights;
+
+  [[nodiscard]] uint32_t nodes() const { return static_cast<uint32_t>(offsets.size() - 1); }
+};
+
+inline WeightedGraph randomGraph(uint32_t nodes, uint32_t degree, uint32_t maxWeight, uint32_t seed = 42) {
+  Lcg rnd{seed};
+  WeightedGraph g;
+  g.offsets.reserve(nodes + 1);
+  g.offsets.push_back(0);
+  for (uint32_t v = 0; v < nodes; ++v) {
+    for (uint32_t e = 0; e < degree; ++e) {
+      g.targets.push_back(((rnd() << 16) ^ rnd()) % nodes);
+      g.weights.push_back(1 + rnd() % maxWeight);
+    }
+    if (v + 1 < nodes) {
+      g.targets.push_back(v + 1);
+      g.weights.push_back(maxWeight);
+    }
+    g.offsets.push_back(static_cast<uint32_t>(g.targets.size()));
+  }
+  return g;
+}
+
+/**
+ * @brief Dijkstra node walking a WeightedGraph from node 0 to the last node
+ */
+struct GraphNode {
+  const WeightedGraph *g{};
+  uint32_t v{}, costs{};
+
+  template <typename Emit> void next(Emit &&emit) const {
+    for (auto e = g->offsets[v]; e < g->offsets[v + 1]; ++e)
+      emit(costs + g->weights[e], g, g->targets[e], costs + g->weights[e]);
+  }
+
+  [[nodiscard]] bool completed() const { return v + 1 == g->nodes(); }
+  [[nodiscard]] uint32_t id() const { return v; }
+};
+
+/**
+ * @brief Dijkstra node walking a weight grid from the top left to the bottom right corner
+ */
+struct GridNode {
+  const AoC::numericGrid<uint_fast8_t> *g{};
+  uint32_t x{}, y{}, costs{};
+
+  template <typename Emit> void next(Emit &&emit) const {
+    auto move = [&](uint32_t nx, uint32_t ny) {
+      auto const c = costs + (*g)[std::pair{nx, ny}];
+      emit(c, g, nx, ny, c);
+    };
+    if (x > 0)
+      move(x - 1, y);
+    if (y > 0)
+      move(x, y - 1);
+    if (x + 1 < g->columns())
+      move(x + 1, y);
+    if (y + 1 < g->rows())
+      move(x, y + 1);
+  }
+
+  [[nodiscard]] bool completed() const { return x + 1 == g->columns() && y + 1 == g->rows(); }
+  [[nodiscard]] uint32_t id() const { return y * static_cast<uint32_t>(g->columns()) + x; }
+};
+
+} // namespace bench
+
+#endif // BENCH_GENERATORS_H
@@ -0,0 +1,57 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "automaton.h"
+#include "generators.h"
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+
+// Game of life steps: the whole grid on one or all threads, and the active set on a grid that has mostly settled.
+
+namespace {
+
+constexpr auto life = [](uint_fast8_t cell, const std::array<uint_fast8_t, 8> &n) -> uint_fast8_t {
+  auto const alive = std::accumulate(n.begin(), n.end(), 0);
+  return alive == 3 || (cell && alive == 2);
+};
+
+AoC::numericGrid<uint_fast8_t> lifeGrid(std::size_t side) {
+  auto grid = bench::weightGrid(side, side);
+  for (auto &v : grid)
+    v = v > 6;
+  return grid;
+}
+
+void BM_life(benchmark::State &state, bool active) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  AoC::Automaton<uint_fast8_t> automaton{lifeGrid(side)};
+  automaton.setThreads(static_cast<unsigned>(state.range(1)));
+  automaton.enableActiveSet(active);
+  // let the random start settle, so most cells are still lifes or empty
+  automaton.run(AoC::stencil8, life, 200);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(automaton.step(AoC::stencil8, life));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * side * side));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_life, full, false)->Args({1000, 1})->Args({1000, 0})->UseRealTime();
+BENCHMARK_CAPTURE(BM_life, active, true)->Args({1000, 1})->Args({1000, 0})->UseRealTime();
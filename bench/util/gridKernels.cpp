@@ -0,0 +1,265 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gridKernels.h"
+#include "numericGrid.h"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+
+// Every kernel is measured three times: through the grid Iterator (the way puzzles did it so far), with the scalar kernel
+// and with the kernel picked by the runtime dispatch.
+
+namespace {
+
+std::string digits(std::size_t side) {
+  std::string input;
+  input.reserve(side * (side + 1));
+  for (std::size_t y = 0; y < side; ++y) {
+    for (std::size_t x = 0; x < side; ++x)
+      input.push_back(static_cast<char>('0' + (x * 7 + y * 3) % 10));
+    input.push_back('\n');
+  }
+  return input;
+}
+
+AoC::numericGrid<uint_fast8_t> grid(std::size_t side) { return AoC::numericGrid<uint_fast8_t>::fromString(digits(side)); }
+
+void setBytes(benchmark::State &state, std::size_t side) { state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * side * side)); }
+
+// decode
+
+void BM_decode_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto input = digits(side);
+  std::vector<uint_fast8_t> out(input.size());
+  for (auto _ : state) {
+    auto it = out.begin();
+    for (auto c : input)
+      *it++ = static_cast<uint_fast8_t>(c - '0');
+    benchmark::DoNotOptimize(out.data());
+  }
+  setBytes(state, side);
+}
+
+void BM_decode_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto input = digits(side);
+  std::vector<std::uint8_t> out(input.size());
+  for (auto _ : state) {
+    table.decodeDigits(input.data(), out.data(), input.size());
+    benchmark::DoNotOptimize(out.data());
+  }
+  setBytes(state, side);
+}
+
+// add
+
+void BM_add_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    for (auto &v : g)
+      ++v;
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+void BM_add_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    table.add(g.data(), g.size(), 1);
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+// sub
+
+void BM_sub_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    for (auto &v : g)
+      --v;
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+void BM_sub_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    table.sub(g.data(), g.size(), 1);
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+// saturate
+
+void BM_addSaturate_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    for (auto &v : g)
+      v = v > 250 ? 255 : v + 5;
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+void BM_addSaturate_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    table.addSaturate(g.data(), g.size(), 5);
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+void BM_subSaturate_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    for (auto &v : g)
+      v = v < 5 ? 0 : v - 5;
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+void BM_subSaturate_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    table.subSaturate(g.data(), g.size(), 5);
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+// clamp
+
+void BM_clamp_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    for (auto &v : g)
+      v = std::clamp<uint_fast8_t>(v, 2, 7);
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+void BM_clamp_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    table.clamp(g.data(), g.size(), 2, 7);
+    benchmark::DoNotOptimize(g.data());
+  }
+  setBytes(state, side);
+}
+
+// count
+
+void BM_countEqual_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (auto v : g)
+      count += v == 9;
+    benchmark::DoNotOptimize(count);
+  }
+  setBytes(state, side);
+}
+
+void BM_countEqual_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(table.countEqual(g.data(), g.size(), 9));
+  setBytes(state, side);
+}
+
+void BM_countAtLeast_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (auto v : g)
+      count += v >= 9;
+    benchmark::DoNotOptimize(count);
+  }
+  setBytes(state, side);
+}
+
+void BM_countAtLeast_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(table.countAtLeast(g.data(), g.size(), 9));
+  setBytes(state, side);
+}
+
+// find, the only match is the very last cell
+
+void BM_findAtLeast_iterator(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  g.clamp(0, 8);
+  *(g.end() - 1) = 9;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(std::find_if(g.begin(), g.end(), [](auto v) { return v >= 9; }));
+  setBytes(state, side);
+}
+
+void BM_findAtLeast_kernel(benchmark::State &state, const AoC::kernels::KernelTable &table) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto g = grid(side);
+  g.clamp(0, 8);
+  *(g.end() - 1) = 9;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(table.findAtLeast(g.data(), g.size(), 9));
+  setBytes(state, side);
+}
+
+#define KERNEL_BENCHMARK(NAME)                                                                                                                                 \
+  BENCHMARK(BM_##NAME##_iterator)->Arg(100)->Arg(1000)->Arg(4000);                                                                                             \
+  BENCHMARK_CAPTURE(BM_##NAME##_kernel, scalar, AoC::kernels::scalar::table)->Arg(100)->Arg(1000)->Arg(4000);                                                  \
+  BENCHMARK_CAPTURE(BM_##NAME##_kernel, dispatched, AoC::kernels::table())->Arg(100)->Arg(1000)->Arg(4000);
+
+KERNEL_BENCHMARK(decode)
+KERNEL_BENCHMARK(add)
+KERNEL_BENCHMARK(sub)
+KERNEL_BENCHMARK(addSaturate)
+KERNEL_BENCHMARK(subSaturate)
+KERNEL_BENCHMARK(clamp)
+KERNEL_BENCHMARK(countEqual)
+KERNEL_BENCHMARK(countAtLeast)
+KERNEL_BENCHMARK(findAtLeast)
+
+} // namespace
@@ -0,0 +1,189 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "generators.h"
+#include "gridScan.h"
+#include "numericGrid.h"
+#include "parallelGrid.h"
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string>
+
+// Loading and walking a numericGrid: the three input paths, full grid iteration, row versus column access (through
+// ColumnView, a transposed copy and the direction scans), and the parallel reduction.
+
+namespace {
+
+void setBytes(benchmark::State &state, std::size_t cells) { state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * cells)); }
+
+void BM_load_istream(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const text = bench::gridText(side, side);
+  for (auto _ : state) {
+    std::istringstream in{text};
+    AoC::numericGrid<uint_fast8_t> grid;
+    in >> grid;
+    benchmark::DoNotOptimize(grid.data());
+  }
+  setBytes(state, text.size());
+}
+
+void BM_load_fromString(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const text = bench::gridText(side, side);
+  for (auto _ : state) {
+    auto grid = AoC::numericGrid<uint_fast8_t>::fromString(text);
+    benchmark::DoNotOptimize(grid.data());
+  }
+  setBytes(state, text.size());
+}
+
+void BM_load_fromFile(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const text = bench::gridText(side, side);
+  std::string const path = "numericGrid_bench_" + std::to_string(side) + ".txt";
+  std::ofstream{path} << text;
+  for (auto _ : state) {
+    auto grid = AoC::numericGrid<uint_fast8_t>::fromFile(path);
+    benchmark::DoNotOptimize(grid.data());
+  }
+  std::remove(path.c_str());
+  setBytes(state, text.size());
+}
+
+void BM_iterate(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    uint32_t sum = 0;
+    for (auto v : grid)
+      sum += v;
+    benchmark::DoNotOptimize(sum);
+  }
+  setBytes(state, grid.size());
+}
+
+void BM_iterate_rows(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    uint32_t sum = 0;
+    for (std::size_t y = 0; y < grid.rows(); ++y)
+      for (auto v : grid[y])
+        sum += v;
+    benchmark::DoNotOptimize(sum);
+  }
+  setBytes(state, grid.size());
+}
+
+void BM_iterate_positions(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    uint32_t sum = 0;
+    for (std::size_t y = 0; y < grid.rows(); ++y)
+      for (std::size_t x = 0; x < grid.columns(); ++x)
+        sum += grid[std::pair{x, y}];
+    benchmark::DoNotOptimize(sum);
+  }
+  setBytes(state, grid.size());
+}
+
+void BM_columnScan(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    uint32_t sum = 0;
+    for (std::size_t x = 0; x < grid.columns(); ++x) {
+      auto column = grid.column(x);
+      sum += std::accumulate(column.begin(), column.end(), uint32_t{0});
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  setBytes(state, grid.size());
+}
+
+void BM_columnScan_transposed(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    auto const t = grid.transposed();
+    uint32_t sum = 0;
+    for (std::size_t x = 0; x < t.rows(); ++x)
+      for (auto v : t[x])
+        sum += v;
+    benchmark::DoNotOptimize(sum);
+  }
+  setBytes(state, grid.size());
+}
+
+void BM_prefixMax_columns(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    AoC::numericGrid<uint_fast8_t> out{side, side};
+    for (std::size_t x = 0; x < side; ++x) {
+      uint_fast8_t acc = 0;
+      auto src = grid.column(x);
+      auto dst = out.column(x);
+      for (std::size_t y = 0; y < side; ++y) {
+        dst[y] = acc;
+        acc = std::max(acc, src[y]);
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  setBytes(state, grid.size());
+}
+
+void BM_prefixMax_scan(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    auto scan = AoC::scanDirections(grid, uint_fast8_t{0}, [](uint_fast8_t a, uint_fast8_t b) { return std::max(a, b); });
+    benchmark::DoNotOptimize(scan.fromTop.data());
+  }
+  // all four directions
+  setBytes(state, 4 * grid.size());
+}
+
+void BM_reduce_parallel(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(AoC::parallelReduce(grid, uint32_t{0}, std::plus<>{}, static_cast<unsigned>(state.range(1))));
+  setBytes(state, grid.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_load_istream)->Arg(100)->Arg(1000);
+BENCHMARK(BM_load_fromString)->Arg(100)->Arg(1000);
+BENCHMARK(BM_load_fromFile)->Arg(100)->Arg(1000);
+BENCHMARK(BM_iterate)->Arg(100)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_iterate_rows)->Arg(100)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_iterate_positions)->Arg(100)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_columnScan)->Arg(100)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_columnScan_transposed)->Arg(100)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_prefixMax_columns)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_prefixMax_scan)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_reduce_parallel)->Args({1000, 1})->Args({4000, 1})->Args({4000, 0})->UseRealTime();
@@ -0,0 +1,89 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bitGrid.h"
+#include "generators.h"
+#include "nibbleGrid.h"
+#include "numericGrid.h"
+#include <benchmark/benchmark.h>
+
+// Packed storage against byte cells: thresholds, masks and neighbour masks over the whole grid.
+
+namespace {
+
+void setCells(benchmark::State &state, std::size_t cells) { state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cells)); }
+
+void BM_countAtLeast_byte(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(grid.countAtLeast(5));
+  setCells(state, grid.size());
+}
+
+void BM_countAtLeast_nibble(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  AoC::nibbleGrid const grid{bench::weightGrid(side, side)};
+  for (auto _ : state)
+    benchmark::DoNotOptimize(grid.countAtLeast(5));
+  setCells(state, grid.size());
+}
+
+void BM_addSaturate_nibble(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  AoC::nibbleGrid grid{bench::weightGrid(side, side)};
+  for (auto _ : state) {
+    grid.addSaturate(1);
+    benchmark::DoNotOptimize(grid.words().data());
+  }
+  setCells(state, grid.size());
+}
+
+void BM_neighbours_byte(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  auto const grid = bench::weightGrid(side, side);
+  for (auto _ : state) {
+    AoC::numericGrid<uint8_t> out{side, side};
+    for (std::size_t y = 0; y < side; ++y)
+      for (std::size_t x = 0; x < side; ++x)
+        if (grid[std::pair{x, y}] >= 9)
+          for (auto p : grid.neighbours8({x, y}))
+            out[p] = 1;
+    benchmark::DoNotOptimize(out.data());
+  }
+  setCells(state, grid.size());
+}
+
+void BM_neighbours_bit(benchmark::State &state) {
+  auto const side = static_cast<std::size_t>(state.range(0));
+  AoC::bitGrid const mask{bench::weightGrid(side, side), [](auto v) { return v >= 9; }};
+  for (auto _ : state) {
+    auto out = mask.neighbours(AoC::stencil8);
+    benchmark::DoNotOptimize(out.words().data());
+  }
+  setCells(state, mask.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_countAtLeast_byte)->Arg(100)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_countAtLeast_nibble)->Arg(100)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_addSaturate_nibble)->Arg(100)->Arg(1000)->Arg(4000);
+BENCHMARK(BM_neighbours_byte)->Arg(100)->Arg(1000);
+BENCHMARK(BM_neighbours_bit)->Arg(100)->Arg(1000);
@@ -0,0 +1,319 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BIDIRECTIONALDIJKSTRA_H
+#define BIDIRECTIONALDIJKSTRA_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <countingResource.h>
+
+#include "dijkstra.h"
+#include "nodeStore.h"
+#include "priorityQueue.h"
+
+namespace AoC {
+
+/**
+ * @class BidirectionalDijkstra
+ * @brief point to point Dijkstra, that searches from the start and the goal at
+ * the same time.
+ *
+ * The forward search follows `next()`, the backward search follows `prev()`
+ * from the goal node. Each round expands the direction with the cheaper
+ * frontier, and every time one search reaches a state the other one already
+ * knows, the sum of both costs is a candidate for the result. The search stops
+ * once the two cheapest frontier entries together can not beat the best
+ * candidate anymore. On grids and road like graphs, both searches meet in the
+ * middle and settle far fewer nodes than a one sided search.
+ *
+ * The costs returned by `prev()` are the costs from the predecessor to the
+ * goal, so the goal node is passed with the costs of `Key{}`. Costs must not be
+ * negative. `completed()` is not used, the goal is given explicitly.
+ *
+ * solve() returns the node, where both searches met, not the goal. With
+ * trackPath() enabled, both searches keep their expanded nodes with a link to
+ * their parent, and path() joins both halves into the full path from the start
+ * to the goal.
+ *
+ * Only nodes with a range returning or an emitting `next()` are supported,
+ * nodes with a PMR aware `next()` (HasPMRNext) are rejected by the
+ * requirements.
+ *
+ * @tparam T Node type, with a range returning or emitting `next()`, an identity
+ *   and a `prev()` function
+ * @tparam Key Key type
+ * @tparam Complexity estimated number of nodes per direction, used to size the
+ *   first chunk of the node pool
+ * @tparam QueuePolicy the priority queue implementation
+ */
+template <DijkstraNode T, class Key, size_t Complexity, class QueuePolicy = AutoQueuePolicy>
+requires(HasNext<T> || HasEmitNext<T>) && HasIdentity<T> && HasPrev<T>
+class BidirectionalDijkstra {
+  using id_t = std::remove_cvref_t<decltype(std::declval<T>().id())>;
+
+  // a node, and the trail index of the node it was reached from
+  struct Entry {
+    template <typename... Args>
+    explicit Entry(uint32_t p, Args &&...args) : node(std::forward<Args>(args)...), parent{p} {}
+
+    T node;
+    uint32_t parent;
+  };
+  static constexpr uint32_t noParent = std::numeric_limits<uint32_t>::max();
+
+  using handle_t = typename NodeStore<Entry>::handle;
+  using queue_t = typename QueuePolicy::template queue<Key, handle_t>;
+
+  // best known costs of a state, and the parent they were reached from
+  struct Known {
+    Key cost;
+    uint32_t parent;
+  };
+
+  struct Side {
+    explicit Side(std::pmr::memory_resource *mr) : heap{mr}, best{mr}, trail{mr} {}
+
+    queue_t heap;
+    std::pmr::unordered_map<id_t, Known> best;
+    // expanded nodes, only filled with trackPath()
+    NodeStore<Entry> trail;
+  };
+
+public:
+  using node_type = T;
+  using key_type = Key;
+
+  /**
+   * @brief Constructor.
+   *
+   * @param start the starting node
+   * @param goal the goal node
+   * @param upstream memory resource for all allocations
+   */
+  BidirectionalDijkstra(T start, T goal, std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : m_upstream{upstream} {
+    push(Forward, Key{}, m_nodes.emplace(noParent, std::move(start)));
+    push(Backward, Key{}, m_nodes.emplace(noParent, std::move(goal)));
+  }
+
+  /**
+   * @brief solves the path from start to goal
+   *
+   * @return a pair of the costs and a copy of the node where both searches met,
+   *   as it was reached by the search that found the meeting. If there is no
+   *   path, the costs are the maximum of Key.
+   */
+  std::pair<const Key, T> solve() {
+    while (step()) {
+    }
+    return {m_lowest, m_winner};
+  }
+
+  /**
+   * @brief solves the path from start to goal, and reconstructs it.
+   *
+   * Enables trackPath(), if it is not enabled yet.
+   *
+   * @return a pair of the costs and the nodes from the start to the goal, empty
+   *   if there is no path
+   * @throws std::logic_error if the search was started without trackPath()
+   */
+  std::pair<const Key, std::vector<T>> solveWithPath() {
+    if (!m_trackPath)
+      trackPath();
+    auto const cost = solve().first;
+    return {cost, path()};
+  }
+
+  /**
+   * @brief keep the expanded nodes of both searches, so path() can
+   *   reconstruct the path
+   *
+   * @param enable true to keep the trails of expanded nodes
+   * @throws std::logic_error if the search is already running
+   */
+  void trackPath(bool enable = true) {
+    if (m_started)
+      throw std::logic_error("BidirectionalDijkstra: trackPath() after the search was started");
+    m_trackPath = enable;
+  }
+
+  /**
+   * @brief the best path from the start to the goal found so far
+   *
+   * The nodes up to the meeting node are the ones of the forward search, the
+   * nodes after it the ones of the backward search, with the costs as seen by
+   * their search.
+   *
+   * @return the nodes from the start to the goal, both included. Empty, if the
+   *   searches did not meet yet.
+   * @throws std::logic_error if trackPath() is not enabled
+   */
+  [[nodiscard]] std::vector<T> path() const {
+    if (!m_trackPath)
+      throw std::logic_error("BidirectionalDijkstra: path() requires trackPath()");
+    std::vector<T> out;
+    if (m_lowest == std::numeric_limits<Key>::max())
+      return out;
+    auto const &forward = m_sides[Forward].trail, &backward = m_sides[Backward].trail;
+    for (auto i = m_meet[Forward]; i != noParent; i = forward[i].parent)
+      out.push_back(forward[i].node);
+    std::ranges::reverse(out);
+    out.push_back(m_winner);
+    for (auto i = m_meet[Backward]; i != noParent; i = backward[i].parent)
+      out.push_back(backward[i].node);
+    return out;
+  }
+
+  /**
+   * @brief expand the cheapest frontier node of one direction.
+   *
+   * @return false, if the search is finished
+   */
+  bool step() {
+    for (auto &s : m_sides)
+      while (!s.heap.empty() && stale(s, s.heap.top()))
+        pop(s);
+    if (done())
+      return false;
+    m_started = true;
+
+    auto const dir = m_sides[Forward].heap.top().first <= m_sides[Backward].heap.top().first ? Forward : Backward;
+    auto &s = m_sides[dir];
+    // the slabs never move, so the node can be expanded in place
+    auto const h = s.heap.top().second;
+    s.heap.pop();
+    ++m_stats.expanded;
+    if (m_trackPath) {
+      auto const parent = s.trail.emplace(std::move(m_nodes[h]));
+      m_nodes.erase(h);
+      expand(dir, s.trail[parent].node, parent);
+    } else {
+      expand(dir, m_nodes[h].node, noParent);
+      m_nodes.erase(h);
+    }
+    return true;
+  }
+
+  /** @brief true if there is nothing left to do */
+  [[nodiscard]] bool done() const {
+    auto const &f = m_sides[Forward].heap, &b = m_sides[Backward].heap;
+    if (f.empty() || b.empty())
+      return true;
+    // no path through the frontiers can be cheaper than the best meeting
+    return m_lowest != std::numeric_limits<Key>::max() && !(f.top().first + b.top().first < m_lowest);
+  }
+
+  /** @brief costs of the best path found so far */
+  [[nodiscard]] Key lowest() const { return m_lowest; }
+
+  /** @brief the meeting node of the best path found so far */
+  [[nodiscard]] const T &winner() const { return m_winner; }
+
+  /** @brief memory and work statistics of both directions since construction */
+  [[nodiscard]] DijkstraStats stats() const {
+    auto s = m_stats;
+    s.peakUpstream = m_upstream.peak();
+    return s;
+  }
+
+private:
+  enum Direction : std::size_t { Forward = 0, Backward = 1 };
+
+  // push the successors of an expanded node, in the direction of its search
+  void expand(Direction dir, const T &node, uint32_t parent) {
+    if (dir == Backward) {
+      for (auto &[cost, n] : node.prev())
+        push(dir, cost, m_nodes.emplace(parent, std::move(n)));
+    } else if constexpr (HasEmitNext<T>) {
+      node.next([this, parent](Key cost, auto &&...args) {
+        push(Forward, cost, m_nodes.emplace(parent, std::forward<decltype(args)>(args)...));
+      });
+    } else {
+      for (auto &[cost, n] : node.next())
+        push(dir, cost, m_nodes.emplace(parent, std::move(n)));
+    }
+  }
+
+  // queue a node from the node store, or drop it if its state is known cheaper
+  void push(Direction dir, Key cost, handle_t h) {
+    auto &s = m_sides[dir];
+    auto const &e = m_nodes[h];
+    auto const id = e.node.id();
+    auto [it, inserted] = s.best.try_emplace(id, Known{cost, e.parent});
+    if (!inserted) {
+      if (!(cost < it->second.cost)) {
+        m_nodes.erase(h);
+        return;
+      }
+      it->second = {cost, e.parent};
+    }
+
+    // the other direction knows this state already, we have a path
+    auto const &other = m_sides[1 - dir].best;
+    if (auto o = other.find(id); o != other.end() && cost + o->second.cost < m_lowest) {
+      m_lowest = cost + o->second.cost;
+      m_winner = e.node;
+      m_meet[dir] = e.parent;
+      m_meet[1 - dir] = o->second.parent;
+    }
+
+    s.heap.push(cost, h);
+    ++m_stats.pushed;
+    m_stats.peakQueue = std::max(m_stats.peakQueue, m_sides[Forward].heap.size() + m_sides[Backward].heap.size());
+  }
+
+  void pop(Side &s) {
+    m_nodes.erase(s.heap.top().second);
+    s.heap.pop();
+  }
+
+  bool stale(const Side &s, const typename queue_t::value_type &e) const {
+    return s.best.find(m_nodes[e.second].node.id())->second.cost < e.first;
+  }
+
+  bool m_trackPath{false}, m_started{false};
+  Key m_lowest{std::numeric_limits<Key>::max()};
+  T m_winner{};
+  // the parents of the meeting node in both directions
+  std::array<uint32_t, 2> m_meet{noParent, noParent};
+  DijkstraStats m_stats;
+
+  CountingResource m_upstream;
+  std::pmr::monotonic_buffer_resource m_buff{std::max<std::size_t>(2 * sizeof(Entry) * Complexity, 1), &m_upstream};
+  std::pmr::unsynchronized_pool_resource m_pool{&m_buff};
+  NodeStore<Entry> m_nodes{&m_pool};
+
+  std::array<Side, 2> m_sides{Side{&m_pool}, Side{&m_pool}};
+};
+
+} // namespace AoC
+
+#endif // BIDIRECTIONALDIJKSTRA_H
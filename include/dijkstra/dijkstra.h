@@ -20,13 +20,26 @@
 #ifndef DIJKSTRA_H
 #define DIJKSTRA_H
 
+#include <algorithm>
 #include <array>
 #include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory_resource>
-#include <queue>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include <countingResource.h>
+
+#include "nodeStore.h"
+#include "priorityQueue.h"
+
 namespace AoC {
 
 /**
@@ -69,6 +82,46 @@ concept HasPMRNext = requires(T t) {
     } -> SortablePair;
 };
 
+/**
+ * @brief archetype of the sink passed to an emitting `next()`.
+ *
+ * The solver passes a callable, that accepts the costs followed by either a
+ * node, or the constructor arguments of a node.
+ */
+struct EmitArchetype {
+  template <typename K, typename... Args> void operator()(K &&, Args &&...) const {}
+};
+
+/**
+ * @concept HasEmitNext
+ *
+ * @brief Fulfilled if the objects provides a `T.next(emit)` function, that
+ * passes every successor to the sink `emit(cost, node)` or
+ * `emit(cost, constructor args...)` instead of returning a range.
+ *
+ * No container is created for the successors, and with constructor arguments
+ * the node is built directly in the node pool. The function should be declared
+ * with a `void` return type, e.g.
+ * `template <typename Emit> void next(Emit &&emit) const`.
+ */
+template <typename T>
+concept HasEmitNext = requires(T t, EmitArchetype e) {
+  { t.next(e) } -> std::same_as<void>;
+};
+
+/**
+ * @concept HasPrev
+ *
+ * @brief Fulfilled if the objects provides a `T.prev()` function that returns
+ * the predecessors of a node as SortablePair, the reverse of `T.next()`
+ */
+template <typename T>
+concept HasPrev = requires(T t) {
+  t.prev();
+  { t.prev() } -> std::ranges::range;
+  { *t.prev().begin() } -> SortablePair;
+};
+
 /**
  * @concept HasCompleted
  *
@@ -82,20 +135,65 @@ concept HasCompleted = requires(T t) {
   { t.completed() } -> std::convertible_to<bool>;
 };
 
+/**
+ * @concept HasIdentity
+ *
+ * @brief Fulfilled if the object has a `T.id()` function that returns a
+ * hashable and equality comparable state key.
+ *
+ * Two nodes with the same id are the same state of the problem, no matter how
+ * they were reached. This enables the duplicate state pruning of Dijkstra.
+ */
+template <typename T>
+concept HasIdentity = requires(T t) {
+  t.id();
+  { std::hash<std::remove_cvref_t<decltype(t.id())>>{}(t.id()) } -> std::convertible_to<std::size_t>;
+  { t.id() == t.id() } -> std::convertible_to<bool>;
+};
+
 /**
  * @concept DijkstraNode
  *
  * @brief Requirements for a Dijkstra node object
  *
  * To fulfill this requirements, an object has to implement:
- * - HasNext OR HasPMRNext
+ * - HasNext OR HasPMRNext OR HasEmitNext
  * - HasCompleted
  * - std::is_default_constructible_v
  * - std::movable
+ *
+ * Optionally, it may implement HasIdentity.
  */
 template <typename T>
 concept DijkstraNode = std::is_default_constructible_v<T> && std::movable<T> &&
-    (HasNext<T> || HasPMRNext<T>)&&HasCompleted<T>;
+    (HasNext<T> || HasPMRNext<T> || HasEmitNext<T>)&&HasCompleted<T>;
+
+/**
+ * @brief search modes of Dijkstra
+ */
+enum class DijkstraMode {
+  /// drain the whole heap, the winner is only final once solve() returns
+  Exhaustive,
+  /// stop as soon as the cheapest frontier entry can not beat the winner anymore
+  EarlyExit,
+  /// queue completed nodes like every other node, and report them one by one
+  /// in cost order through nextResult()
+  Stream
+};
+
+/**
+ * @brief memory and work statistics of a Dijkstra run
+ */
+struct DijkstraStats {
+  /// highest number of entries in the priority queue
+  std::size_t peakQueue{};
+  /// highest number of bytes requested from the upstream memory resource
+  std::size_t peakUpstream{};
+  /// number of nodes passed to `next()`
+  std::size_t expanded{};
+  /// number of nodes pushed to the priority queue
+  std::size_t pushed{};
+};
 
 /**
  * @class Dijkstra
@@ -108,34 +206,110 @@ concept DijkstraNode = std::is_default_constructible_v<T> && std::movable<T> &&
  *
  * It utilizes std::pmr resources and std::array for memory management.
  *
- * @warning Be careful with defining the Complexity parameter. An std::array
- *   with  `(sizeof(Key) + sizeof(T*)) Complexity` will be created. This may
- * smash your heap!
+ * If the node type fulfills HasIdentity, the container keeps the best known
+ * costs for every state. Pushes that are not cheaper than the known costs are
+ * dropped, and outdated heap entries are skipped, so every state is expanded
+ * only once. Without it, the same state may be expanded again for every path
+ * that leads to it.
+ *
+ * The search may be run in steps: step() expands a single node, solveUntil()
+ * runs until a predicate holds, and all of them can be resumed later. In
+ * DijkstraMode::EarlyExit, the search stops once no frontier node can beat the
+ * winner. This requires the costs to never decrease along a path.
+ *
+ * The priority queue is selected by the QueuePolicy (see priorityQueue.h). By
+ * default, unsigned integral keys use a radix heap, everything else a binary
+ * heap. The radix heap and the bucket queue are monotone, they require that
+ * the costs never decrease along a path.
+ *
+ * Memory for the priority queue starts in a small buffer inside the object,
+ * and grows in geometric chunks from the upstream memory resource. The node
+ * objects live in a NodeStore, its slabs come from a separate pool with the
+ * same growth strategy. The queue only holds the costs and a 32 bit handle.
+ * Use stats() after a run, to see how much memory it really needed.
+ *
+ * With trackPath() enabled, every expanded node is moved into a trail,
+ * together with the trail index of its parent. solveWithPath() and path()
+ * follow these links back from the winner, so the node types do not need to
+ * carry their own history. The trail grows with every expanded node, so it is
+ * off by default, and expanded nodes are destroyed right away.
  *
  * @tparam T Node type
  * @tparam Key Key type
- * @tparam Complexity estimated complexity.
+ * @tparam Complexity estimated number of nodes, used to size the first chunk of
+ *   the node pool. The inline queue buffer is capped at InlineBytes.
  * @tparam ExtraMem additional memory required for a PMR aware `next()`
+ * @tparam QueuePolicy the priority queue implementation
  */
 
-template <DijkstraNode T, class Key, size_t Complexity, size_t ExtraMem = 0>
+template <DijkstraNode T, class Key, size_t Complexity, size_t ExtraMem = 0, class QueuePolicy = AutoQueuePolicy>
 class Dijkstra {
-  struct heap_t {
-    Key first;
-    T *second;
-    bool operator<(const heap_t &o) const { return o.first < first; }
+  template <typename N> struct identity {
+    using type = std::monostate;
+  };
+  template <HasIdentity N> struct identity<N> {
+    using type = std::pmr::unordered_map<std::remove_cvref_t<decltype(std::declval<N>().id())>, Key>;
   };
+  using best_t = typename identity<T>::type;
+
+  // a node, and the trail index of the node it was reached from
+  struct Entry {
+    // construct the node in place from its constructor arguments
+    template <typename... Args>
+    explicit Entry(uint32_t p, Args &&...args) : node(std::forward<Args>(args)...), parent{p} {}
+
+    T node;
+    uint32_t parent;
+  };
+  static constexpr uint32_t noParent = std::numeric_limits<uint32_t>::max();
+
+  using handle_t = typename NodeStore<Entry>::handle;
+  using queue_t = typename QueuePolicy::template queue<Key, handle_t>;
+  using heap_t = typename queue_t::value_type;
 
 public:
+  using node_type = T;
+  using key_type = Key;
+
+  /** @brief maximum size of the queue buffer inside the object */
+  static constexpr std::size_t InlineBytes = 4096;
+
   /**
    * @brief Constructor.
    *
    * @param node the starting node
    * @param k the costs of the starting node
+   * @param mode the search mode
+   * @param upstream memory resource for everything that does not fit the
+   *   inline buffer
+   */
+  explicit Dijkstra(T node, Key k = {}, DijkstraMode mode = DijkstraMode::Exhaustive,
+                    std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : m_mode{mode}, m_upstream{upstream}, m_heap{&m_stack_pool} {
+    push(k, node, noParent);
+  }
+
+  /**
+   * @brief restart the search from a new node.
+   *
+   * All queued nodes are dropped, but the memory of the container is kept and
+   * reused.
+   *
+   * @param node the starting node
+   * @param k the costs of the starting node
    */
-  explicit Dijkstra(T node, Key k = {})
-      : m_heap{std::less<heap_t>(), std::pmr::vector<heap_t>{&m_stack_pool}} {
-    push(k, node);
+  void reset(T node, Key k = {}) {
+    m_heap.clear();
+    m_nodes.clear();
+    if constexpr (HasIdentity<T>)
+      m_best.clear();
+    m_lowest = std::numeric_limits<Key>::max();
+    m_winner = T{};
+    m_winnerParent = noParent;
+    m_trail.clear();
+    m_started = false;
+    m_result.reset();
+    push(k, node, noParent);
   }
 
   /**
@@ -151,68 +325,306 @@ public:
    * @return a pair of the costs and a copy of the winning node
    */
   std::pair<const Key, T> solve() {
-    while (!m_heap.empty()) {
-      auto &ne = m_heap.top();
-      auto next = getNext(*(ne.second));
+    return solveUntil([](const Dijkstra &) { return false; });
+  }
+
+  /**
+   * @brief solves the provided issue, and reconstructs the path to the winner.
+   *
+   * Enables trackPath(), if it is not enabled yet.
+   *
+   * @return a pair of the costs and the nodes from the start to the winner,
+   *   empty if there is no winner
+   * @throws std::logic_error if the search was started without trackPath()
+   */
+  std::pair<const Key, std::vector<T>> solveWithPath() {
+    if (!m_trackPath)
+      trackPath();
+    auto const cost = solve().first;
+    return {cost, path()};
+  }
+
+  /**
+   * @brief keep the expanded nodes, so path() can reconstruct the path
+   *
+   * The setting is kept by reset(). It can only be changed before the first
+   * step after construction or reset().
+   *
+   * @param enable true to keep the trail of expanded nodes
+   * @throws std::logic_error if the search is already running
+   */
+  void trackPath(bool enable = true) {
+    if (m_started)
+      throw std::logic_error("Dijkstra: trackPath() after the search was started");
+    m_trackPath = enable;
+  }
+
+  /**
+   * @brief the path to the best completed node found so far
+   *
+   * @return the nodes from the start to the winner, both included. Empty, if
+   *   there is no winner yet.
+   * @throws std::logic_error if trackPath() is not enabled
+   */
+  [[nodiscard]] std::vector<T> path() const {
+    if (!m_trackPath)
+      throw std::logic_error("Dijkstra: path() requires trackPath()");
+    std::vector<T> out;
+    if (m_lowest == std::numeric_limits<Key>::max())
+      return out;
+    out.push_back(m_winner);
+    for (auto i = m_winnerParent; i != noParent; i = m_trail[i].parent)
+      out.push_back(m_trail[i].node);
+    std::ranges::reverse(out);
+    return out;
+  }
+
+  /**
+   * @brief solve until a predicate holds.
+   *
+   * `pred` is invoked with the container after every step. The search can be
+   * continued later with another call to any of the solve functions.
+   *
+   * @param pred stop condition, e.g. a step budget
+   * @return a pair of the costs and a copy of the best node found so far
+   */
+  template <std::predicate<const Dijkstra &> Pred>
+  std::pair<const Key, T> solveUntil(Pred pred) {
+    while (step())
+      if (pred(*this))
+        break;
+    return {m_lowest, m_winner};
+  }
+
+  /**
+   * @brief expand the cheapest frontier node.
+   *
+   * @return false, if the search is finished
+   */
+  bool step() {
+    if (done())
+      return false;
+    m_started = true;
+
+    auto &ne = m_heap.top();
+    if (stale(ne)) {
       pop();
+      return true;
+    }
+
+    auto &entry = m_nodes[ne.second];
+    if (m_mode == DijkstraMode::Stream && entry.node.completed()) {
+      if (ne.first < m_lowest) {
+        m_lowest = ne.first;
+        m_winner = entry.node;
+        m_winnerParent = entry.parent;
+      }
+      m_result.emplace(ne.first, std::move(entry.node));
+      pop();
+      return true;
+    }
+
+    // the slabs of both stores never move, so the node can be expanded in place
+    auto const h = ne.second;
+    m_heap.pop();
+    ++m_stats.expanded;
+    if (m_trackPath) {
+      // move the node to the trail, its children link back to it
+      auto const parent = m_trail.emplace(std::move(entry));
+      m_nodes.erase(h);
+      expand(m_trail[parent].node, parent);
+    } else {
+      expand(entry.node, noParent);
+      m_nodes.erase(h);
+    }
+    return true;
+  }
+
+  /**
+   * @brief get the next completed node, in cost order.
+   *
+   * Only available in DijkstraMode::Stream. Every call resumes the search,
+   * until the next completed node leaves the heap.
+   *
+   * @return the costs and the completed node, or std::nullopt if there are
+   *   none left
+   */
+  std::optional<std::pair<Key, T>> nextResult() {
+    m_result.reset();
+    while (!m_result && step()) {
+    }
+    return std::exchange(m_result, std::nullopt);
+  }
+
+  /** @brief true if there is nothing left to do */
+  [[nodiscard]] bool done() const {
+    if (m_heap.empty())
+      return true;
+    return m_mode == DijkstraMode::EarlyExit && !(m_heap.top().first < m_lowest);
+  }
+
+  /** @brief costs of the best completed node found so far */
+  [[nodiscard]] Key lowest() const { return m_lowest; }
+
+  /** @brief the best completed node found so far */
+  [[nodiscard]] const T &winner() const { return m_winner; }
+
+  /** @brief memory and work statistics since construction */
+  [[nodiscard]] DijkstraStats stats() const {
+    auto s = m_stats;
+    s.peakUpstream = m_upstream.peak();
+    return s;
+  }
+
+private:
+  // pass the successors of an expanded node to accept()
+  void expand(T &node, uint32_t parent) {
+    if constexpr (HasEmitNext<T>) {
+      node.next([this, parent](Key cost, auto &&...args) {
+        if constexpr (sizeof...(args) == 1 && (std::same_as<std::remove_cvref_t<decltype(args)>, T> && ...)) {
+          T child{std::forward<decltype(args)>(args)...};
+          accept(cost, child, parent);
+        } else {
+          emplace(cost, parent, std::forward<decltype(args)>(args)...);
+        }
+      });
+    } else {
+      auto next = getNext(node);
       for (auto &n : next) {
-        auto &[cost, node] = n;
-        if (cost > m_lowest)
-          continue;
-        if (node.completed()) {
-          if (cost < m_lowest) {
-            m_lowest = cost;
-            std::swap(m_winner, node);
-          }
-          continue;
+        auto &[cost, child] = n;
+        accept(cost, child, parent);
+      }
+    }
+  }
+
+  // handle a successor of an expanded node
+  void accept(Key cost, T &node, uint32_t parent) {
+    if (m_mode != DijkstraMode::Stream) {
+      if (cost > m_lowest)
+        return;
+      if (node.completed()) {
+        if (cost < m_lowest) {
+          m_lowest = cost;
+          std::swap(m_winner, node);
+          m_winnerParent = parent;
         }
-        push(cost, node);
+        return;
       }
     }
-    return {m_lowest, m_winner};
+    push(cost, node, parent);
   }
 
-private:
-  void push(Key cost, T &n) {
+  // same as accept(), but the node is constructed in the node store
+  template <typename... Args> void emplace(Key cost, uint32_t parent, Args &&...args) {
+    if (m_mode != DijkstraMode::Stream && cost > m_lowest)
+      return;
+    auto const h = m_nodes.emplace(parent, std::forward<Args>(args)...);
+    auto &node = m_nodes[h].node;
+    if (m_mode != DijkstraMode::Stream && node.completed()) {
+      if (cost < m_lowest) {
+        m_lowest = cost;
+        std::swap(m_winner, node);
+        m_winnerParent = parent;
+      }
+      m_nodes.erase(h);
+      return;
+    }
+    if (!improves(cost, node)) {
+      m_nodes.erase(h);
+      return;
+    }
+    enqueue(cost, h);
+  }
+
+  void push(Key cost, T &n, uint32_t parent) {
+    if (!improves(cost, n))
+      return;
     // move our object to the target storage
-    auto ptr = m_alloc.template new_object<T>(std::move(n));
-    // push it to the heap
-    m_heap.emplace(heap_t{.first = cost, .second = ptr});
+    enqueue(cost, m_nodes.emplace(parent, std::move(n)));
+  }
+
+  // false, if we already know a path to this state, that is at least as cheap
+  bool improves(Key cost, const T &n) {
+    if constexpr (HasIdentity<T>) {
+      auto [it, inserted] = m_best.try_emplace(n.id(), cost);
+      if (!inserted) {
+        if (!(cost < it->second))
+          return false;
+        it->second = cost;
+      }
+    }
+    return true;
+  }
+
+  void enqueue(Key cost, handle_t h) {
+    m_heap.push(cost, h);
+    ++m_stats.pushed;
+    m_stats.peakQueue = std::max(m_stats.peakQueue, m_heap.size());
   }
 
   void pop() {
-    auto obj = m_heap.top();
-    m_alloc.delete_object(obj.second);
+    m_nodes.erase(m_heap.top().second);
     m_heap.pop();
   }
 
+  // true if a cheaper path to the state of this entry was pushed after it
+  bool stale(const heap_t &e) const {
+    if constexpr (HasIdentity<T>)
+      return m_best.find(m_nodes[e.second].node.id())->second < e.first;
+    else
+      return false;
+  }
+
   auto getNext(const T &n) requires HasNext<T> { return n.next(); }
 
   auto getNext(const T &n) requires HasPMRNext<T> {
     return n.next(&m_dyn_pool);
   }
 
+  DijkstraMode m_mode;
+  bool m_trackPath{false}, m_started{false};
   Key m_lowest{std::numeric_limits<Key>::max()};
   T m_winner{};
+  uint32_t m_winnerParent{noParent};
+  std::optional<std::pair<Key, T>> m_result;
+  DijkstraStats m_stats;
 
-  // stack memory for the priority queue
-  // We use the stack here, at it is continuous area, that should fit in the CPU
-  // cache as a whole This makes the heap operations a lot faster
-  std::array<std::byte, Complexity * sizeof(heap_t)> m_stack_arena{};
+  // all memory that does not fit into the inline buffer comes from here
+  CountingResource m_upstream;
+
+  // inline memory for the priority queue
+  // The first part of the queue lives inside the object, it is a continuous
+  // area that fits in the CPU cache. Everything beyond is taken from upstream
+  // in geometrically growing chunks.
+  std::array<std::byte, std::clamp<std::size_t>(Complexity * sizeof(heap_t), sizeof(heap_t), InlineBytes)> m_stack_arena{};
   std::pmr::monotonic_buffer_resource m_stack_buff{m_stack_arena.data(),
-                                                   m_stack_arena.size()};
+                                                   m_stack_arena.size(),
+                                                   &m_upstream};
   std::pmr::unsynchronized_pool_resource m_stack_pool{&m_stack_buff};
-  std::priority_queue<heap_t, std::pmr::vector<heap_t>> m_heap;
-
-  // dynamic memory pools are used for the node objects and for the next
-  // function if they support it. our operations on this memory area are much
-  // less optimized, but there is no need to, as it is limited to creation and
-  // deletion of objects (at least for the code within the Dijkstra
-  // implementation)
-  std::pmr::monotonic_buffer_resource m_dyn_buff{(sizeof(T) * Complexity) +
-                                                 ExtraMem};
+  queue_t m_heap;
+
+  // dynamic memory pools are used for the node slabs and for the next
+  // function if they support it. The node objects themselves are created and
+  // destroyed through the node store, without a call into the pool.
+  std::pmr::monotonic_buffer_resource m_dyn_buff{
+      std::max<std::size_t>((sizeof(Entry) * Complexity) + ExtraMem, 1),
+      &m_upstream};
   std::pmr::unsynchronized_pool_resource m_dyn_pool{&m_dyn_buff};
-  std::pmr::polymorphic_allocator<T> m_alloc{&m_dyn_pool};
+  NodeStore<Entry> m_nodes{&m_dyn_pool};
+
+  // expanded nodes, with the links to their parents. Only filled with
+  // trackPath(), the handles are the trail indices.
+  NodeStore<Entry> m_trail{&m_dyn_pool};
+
+  // best known costs per state, only used for nodes with an identity
+  [[no_unique_address]] best_t m_best{makeBest()};
+
+  best_t makeBest() {
+    if constexpr (HasIdentity<T>)
+      return best_t{&m_dyn_pool};
+    else
+      return {};
+  }
 };
 
 } // namespace AoC
@@ -0,0 +1,100 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DIJKSTRABATCH_H
+#define DIJKSTRABATCH_H
+
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <parallel.h>
+
+#include "dijkstra.h"
+
+namespace AoC {
+
+/**
+ * @class DijkstraBatch
+ * @brief solves the same problem from many start nodes in parallel.
+ *
+ * Every worker thread owns one Dijkstra container. It is created for the first
+ * start node the worker picks up, and reset() for every following one, so the
+ * arenas are built once per worker and then reused. The worker threads and
+ * their containers are kept in a WorkerPool between calls to solve().
+ *
+ * The `next()` and `completed()` functions of the nodes are called from several
+ * threads at once. They may share read only data (e.g. the graph), but must not
+ * modify shared state.
+ *
+ * @tparam D the Dijkstra container type, e.g. `Dijkstra<Node, uint32_t, 1000>`
+ */
+template <class D> class DijkstraBatch {
+public:
+  using node_type = typename D::node_type;
+  using key_type = typename D::key_type;
+
+  /**
+   * @brief Constructor.
+   *
+   * @param threads number of worker threads, 0 for all cores
+   * @param mode search mode for every run
+   */
+  explicit DijkstraBatch(unsigned threads = 0, DijkstraMode mode = DijkstraMode::Exhaustive)
+      : m_pool{threads}, m_mode{mode}, m_workers(m_pool.size()) {}
+
+  /**
+   * @brief solve from every start node
+   *
+   * @param starts the start nodes, with the costs of `key_type{}`
+   * @return a pair of the costs and the winning node per start node, in input order
+   */
+  template <std::ranges::random_access_range R>
+  requires std::convertible_to<std::ranges::range_reference_t<R>, const node_type &>
+  std::vector<std::pair<key_type, node_type>> solve(const R &starts) {
+    auto const count = static_cast<std::size_t>(std::ranges::size(starts));
+    std::vector<std::pair<key_type, node_type>> results(count);
+    m_pool.parallelFor(count,
+        [&](unsigned worker, std::size_t i) {
+          auto const &start = std::ranges::begin(starts)[static_cast<std::ranges::range_difference_t<R>>(i)];
+          auto &d = m_workers[worker];
+          if (!d)
+            d = std::make_unique<D>(start, key_type{}, m_mode);
+          else
+            d->reset(start);
+          auto [cost, winner] = d->solve();
+          results[i] = {cost, std::move(winner)};
+        });
+    return results;
+  }
+
+  /** @brief the number of worker threads */
+  [[nodiscard]] unsigned threads() const { return m_pool.size(); }
+
+private:
+  WorkerPool m_pool;
+  DijkstraMode m_mode;
+  std::vector<std::unique_ptr<D>> m_workers;
+};
+
+} // namespace AoC
+
+#endif // DIJKSTRABATCH_H
@@ -0,0 +1,165 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GRIDDIJKSTRA_H
+#define GRIDDIJKSTRA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <numericGrid.h>
+
+#include "priorityQueue.h"
+
+namespace AoC {
+
+/**
+ * @brief heuristic used by GridDijkstra
+ */
+enum class GridHeuristic {
+  None,     ///< plain Dijkstra
+  Manhattan ///< A* with the manhattan distance, scaled by the cheapest cell of the grid
+};
+
+/**
+ * @class GridDijkstra
+ * @brief shortest path over the cells of a weighted numericGrid
+ *
+ * This is the specialized version of Dijkstra for the typical "find the path with the lowest risk" puzzles. Moving to a
+ * cell costs the value of that cell, the start cell itself is free. Only the 4 direct neighbours are reachable.
+ *
+ * Instead of node objects, it works on cell indices: the distances are stored in a flat array, and the heap holds
+ * `(cost, uint32_t index)` pairs only.
+ *
+ * @tparam T cell type of the grid
+ * @tparam Key cost type
+ * @tparam QueuePolicy the priority queue implementation, see priorityQueue.h
+ */
+template <typename T = uint_fast8_t, class Key = uint32_t, class QueuePolicy = AutoQueuePolicy> class GridDijkstra {
+  using queue_t = typename QueuePolicy::template queue<Key, uint32_t>;
+
+public:
+  using Position = std::pair<std::size_t, std::size_t>;
+
+  /**
+   * @brief Constructor.
+   *
+   * @param grid the weights. The grid has to outlive the solver.
+   * @param start start position (x,y)
+   * @param goal target position (x,y)
+   * @param heuristic use plain Dijkstra, or A* with a manhattan heuristic
+   * @throws std::invalid_argument if start or goal are not inside the grid, or the grid has more cells than a
+   * `uint32_t` can index
+   */
+  GridDijkstra(const numericGrid<T> &grid, Position start, Position goal, GridHeuristic heuristic = GridHeuristic::None)
+      : m_grid{&grid}, m_columns{grid.columns()}, m_start{checkedIndex(grid, start)}, m_goal{checkedIndex(grid, goal)}, m_goalPos{goal}, m_heuristic{heuristic},
+        m_dist(grid.size(), unreachable) {
+    if (m_heuristic == GridHeuristic::Manhattan && !grid.empty())
+      m_minWeight = static_cast<Key>(*std::ranges::min_element(grid));
+  }
+
+  /** @brief cost returned for cells that can not be reached */
+  static constexpr Key unreachable = std::numeric_limits<Key>::max();
+
+  /**
+   * @brief solves the path from start to goal
+   *
+   * @return the costs of the cheapest path, or `unreachable`
+   */
+  Key solve() {
+    queue_t heap;
+    m_dist[m_start] = Key{};
+    heap.push(estimate(m_start), m_start);
+
+    const T *weights = m_grid->data();
+    auto const columns = static_cast<uint32_t>(m_columns);
+    auto const size = static_cast<uint32_t>(m_dist.size());
+
+    while (!heap.empty()) {
+      auto [f, idx] = heap.top();
+      heap.pop();
+      auto const cost = m_dist[idx];
+      // stale entry, the cell was settled cheaper already
+      if (f != cost + estimate(idx))
+        continue;
+      if (idx == m_goal)
+        return cost;
+
+      auto relax = [&](uint32_t n) {
+        auto const c = static_cast<Key>(cost + weights[n]);
+        if (c < m_dist[n]) {
+          m_dist[n] = c;
+          heap.push(c + estimate(n), n);
+        }
+      };
+
+      auto const x = idx % columns;
+      if (x > 0)
+        relax(idx - 1);
+      if (x + 1 < columns)
+        relax(idx + 1);
+      if (idx >= columns)
+        relax(idx - columns);
+      if (idx + columns < size)
+        relax(idx + columns);
+    }
+    return m_dist[m_goal];
+  }
+
+  /**
+   * @brief the distance from start to a cell, as far as it was explored by solve()
+   */
+  Key distance(Position pos) const { return m_dist[index(pos)]; }
+
+private:
+  uint32_t index(Position pos) const { return static_cast<uint32_t>(pos.second * m_columns + pos.first); }
+
+  static uint32_t checkedIndex(const numericGrid<T> &grid, Position pos) {
+    if (grid.size() > std::numeric_limits<uint32_t>::max())
+      throw std::invalid_argument("GridDijkstra: grid has too many cells");
+    if (pos.first >= grid.columns() || pos.second >= grid.rows())
+      throw std::invalid_argument("GridDijkstra: position is outside of the grid");
+    return static_cast<uint32_t>(pos.second * grid.columns() + pos.first);
+  }
+
+  Key estimate(uint32_t idx) const {
+    if (m_heuristic == GridHeuristic::None)
+      return Key{};
+    auto const x = idx % m_columns, y = idx / m_columns;
+    auto const dx = x > m_goalPos.first ? x - m_goalPos.first : m_goalPos.first - x;
+    auto const dy = y > m_goalPos.second ? y - m_goalPos.second : m_goalPos.second - y;
+    return static_cast<Key>((dx + dy) * m_minWeight);
+  }
+
+  const numericGrid<T> *m_grid;
+  std::size_t m_columns;
+  uint32_t m_start, m_goal;
+  Position m_goalPos;
+  GridHeuristic m_heuristic;
+  Key m_minWeight{};
+  std::vector<Key> m_dist;
+};
+
+} // namespace AoC
+
+#endif // GRIDDIJKSTRA_H
@@ -0,0 +1,159 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NODESTORE_H
+#define NODESTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace AoC {
+
+/**
+ * @class NodeStore
+ * @brief slab storage for objects of a single type, addressed by 32 bit
+ * handles.
+ *
+ * Objects live in fixed size slabs, that are taken from the memory resource
+ * once and never moved, so references stay valid until the object is erased.
+ * Erased slots go to a free list and are reused first, which keeps the live
+ * objects dense. There is no per object allocation and no virtual call on
+ * emplace() and erase().
+ *
+ * @tparam T the object type
+ * @tparam SlabBits log2 of the number of objects per slab
+ */
+template <class T, std::size_t SlabBits = 8> class NodeStore {
+  static constexpr std::size_t SlabSize = std::size_t{1} << SlabBits;
+
+  union Slot {
+    Slot() {}
+    ~Slot() {}
+
+    T value;
+    uint32_t next;
+  };
+
+public:
+  using handle = uint32_t;
+
+  /** @brief handle that never refers to an object */
+  static constexpr handle none = std::numeric_limits<handle>::max();
+
+  explicit NodeStore(std::pmr::memory_resource *mr = std::pmr::get_default_resource()) : m_mr{mr}, m_slabs{mr} {}
+
+  NodeStore(const NodeStore &) = delete;
+  NodeStore &operator=(const NodeStore &) = delete;
+
+  ~NodeStore() {
+    clear();
+    for (auto *slab : m_slabs)
+      m_mr->deallocate(slab, sizeof(Slot) * SlabSize, alignof(Slot));
+  }
+
+  /**
+   * @brief construct an object
+   * If the constructor of T throws, the store is left unchanged.
+   *
+   * @return the handle of the new object
+   * @throws std::length_error if all handles are in use
+   */
+  template <typename... Args> handle emplace(Args &&...args) {
+    handle h = m_free;
+    bool const reused = h != none;
+    if (reused) {
+      m_free = slot(h).next;
+    } else {
+      if (m_used == none)
+        throw std::length_error("NodeStore: out of handles");
+      if (m_used == m_slabs.size() * SlabSize)
+        m_slabs.push_back(static_cast<Slot *>(m_mr->allocate(sizeof(Slot) * SlabSize, alignof(Slot))));
+      h = static_cast<handle>(m_used++);
+    }
+    try {
+      ::new (static_cast<void *>(std::addressof(slot(h).value))) T(std::forward<Args>(args)...);
+    } catch (...) {
+      // hand the slot back, it never held an object
+      if (reused) {
+        slot(h).next = m_free;
+        m_free = h;
+      } else {
+        --m_used;
+      }
+      throw;
+    }
+    ++m_size;
+    return h;
+  }
+
+  /** @brief destroy an object, its slot is reused by the next emplace() */
+  void erase(handle h) {
+    auto &s = slot(h);
+    std::destroy_at(std::addressof(s.value));
+    s.next = m_free;
+    m_free = h;
+    --m_size;
+  }
+
+  ///@{
+  /** @brief access an object by its handle */
+  T &operator[](handle h) { return slot(h).value; }
+  const T &operator[](handle h) const { return slot(h).value; }
+  ///@}
+
+  /** @brief number of live objects */
+  [[nodiscard]] std::size_t size() const { return m_size; }
+
+  /** @brief number of objects that fit into the allocated slabs */
+  [[nodiscard]] std::size_t capacity() const { return m_slabs.size() * SlabSize; }
+
+  /** @brief destroy all objects, the slabs are kept */
+  void clear() {
+    if (m_size != 0) {
+      // every slot, that is not on the free list, holds a live object
+      std::vector<bool> dead(m_used);
+      for (auto h = m_free; h != none; h = slot(h).next)
+        dead[h] = true;
+      for (std::size_t h = 0; h < m_used; ++h)
+        if (!dead[h])
+          std::destroy_at(std::addressof(slot(static_cast<handle>(h)).value));
+    }
+    m_used = m_size = 0;
+    m_free = none;
+  }
+
+private:
+  Slot &slot(handle h) const { return m_slabs[h >> SlabBits][h & (SlabSize - 1)]; }
+
+  std::pmr::memory_resource *m_mr;
+  std::pmr::vector<Slot *> m_slabs;
+  std::size_t m_used{}, m_size{};
+  handle m_free{none};
+};
+
+} // namespace AoC
+
+#endif // NODESTORE_H
@@ -0,0 +1,329 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AoC {
+
+/**
+ * @brief entry of a priority queue, the smallest `first` is on top
+ */
+template <class Key, class Value> struct QueueEntry {
+  Key first;
+  Value second;
+};
+
+/**
+ * @class BinaryHeapQueue
+ * @brief binary min heap, works for every totally ordered Key
+ */
+template <class Key, class Value> class BinaryHeapQueue {
+public:
+  using value_type = QueueEntry<Key, Value>;
+
+  explicit BinaryHeapQueue(std::pmr::memory_resource *mr = std::pmr::get_default_resource()) : m_heap{mr} {}
+
+  void push(Key k, Value v) {
+    m_heap.push_back(value_type{k, std::move(v)});
+    std::push_heap(m_heap.begin(), m_heap.end(), cmp);
+  }
+
+  [[nodiscard]] const value_type &top() const { return m_heap.front(); }
+
+  void pop() {
+    std::pop_heap(m_heap.begin(), m_heap.end(), cmp);
+    m_heap.pop_back();
+  }
+
+  [[nodiscard]] bool empty() const { return m_heap.empty(); }
+  [[nodiscard]] std::size_t size() const { return m_heap.size(); }
+  void clear() { m_heap.clear(); }
+
+private:
+  static bool cmp(const value_type &a, const value_type &b) { return b.first < a.first; }
+
+  std::pmr::vector<value_type> m_heap;
+};
+
+/**
+ * @class DaryHeapQueue
+ * @brief D-ary min heap.
+ *
+ * Compared to the binary heap, the tree is flatter and the children of a node
+ * share a cache line, at the price of more comparisons per level.
+ *
+ * @tparam D number of children per node
+ */
+template <class Key, class Value, std::size_t D = 4> class DaryHeapQueue {
+  static_assert(D >= 2, "a heap needs at least two children per node");
+
+public:
+  using value_type = QueueEntry<Key, Value>;
+
+  explicit DaryHeapQueue(std::pmr::memory_resource *mr = std::pmr::get_default_resource()) : m_heap{mr} {}
+
+  void push(Key k, Value v) {
+    value_type e{k, std::move(v)};
+    std::size_t i = m_heap.size();
+    m_heap.emplace_back();
+    while (i > 0) {
+      std::size_t parent = (i - 1) / D;
+      if (!(e.first < m_heap[parent].first))
+        break;
+      m_heap[i] = std::move(m_heap[parent]);
+      i = parent;
+    }
+    m_heap[i] = std::move(e);
+  }
+
+  [[nodiscard]] const value_type &top() const { return m_heap.front(); }
+
+  void pop() {
+    value_type e = std::move(m_heap.back());
+    m_heap.pop_back();
+    auto const n = m_heap.size();
+    if (n == 0)
+      return;
+    std::size_t i = 0;
+    for (;;) {
+      std::size_t first = i * D + 1;
+      if (first >= n)
+        break;
+      std::size_t last = std::min(first + D, n), best = first;
+      for (std::size_t c = first + 1; c < last; ++c)
+        if (m_heap[c].first < m_heap[best].first)
+          best = c;
+      if (!(m_heap[best].first < e.first))
+        break;
+      m_heap[i] = std::move(m_heap[best]);
+      i = best;
+    }
+    m_heap[i] = std::move(e);
+  }
+
+  [[nodiscard]] bool empty() const { return m_heap.empty(); }
+  [[nodiscard]] std::size_t size() const { return m_heap.size(); }
+  void clear() { m_heap.clear(); }
+
+private:
+  std::pmr::vector<value_type> m_heap;
+};
+
+/**
+ * @class RadixHeapQueue
+ * @brief monotone radix heap for unsigned integral keys.
+ *
+ * Entries are sorted into buckets by the highest bit in which their key differs
+ * from the last popped key. Every entry moves down at most once per bit, so
+ * push and pop are amortized O(log C) with very cheap operations.
+ *
+ * @warning the queue is monotone: a pushed key must not be smaller than the
+ * last popped one. This holds for Dijkstra with non negative costs, and for A*
+ * with a consistent heuristic. Otherwise push() throws std::logic_error.
+ */
+template <class Key, class Value> class RadixHeapQueue {
+  static_assert(std::unsigned_integral<Key>, "the radix heap requires unsigned integral keys");
+  static constexpr std::size_t Buckets = std::numeric_limits<Key>::digits + 1;
+
+public:
+  using value_type = QueueEntry<Key, Value>;
+
+  explicit RadixHeapQueue(std::pmr::memory_resource *mr = std::pmr::get_default_resource()) : m_buckets{makeBuckets(mr, std::make_index_sequence<Buckets>{})} {}
+
+  void push(Key k, Value v) {
+    if (k < m_last)
+      throw std::logic_error("RadixHeapQueue: key is smaller than the last popped one");
+    m_buckets[bucket(k)].push_back(value_type{k, std::move(v)});
+    ++m_size;
+  }
+
+  [[nodiscard]] const value_type &top() const {
+    pull();
+    return m_buckets[0].back();
+  }
+
+  void pop() {
+    pull();
+    m_buckets[0].pop_back();
+    --m_size;
+  }
+
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+  [[nodiscard]] std::size_t size() const { return m_size; }
+
+  void clear() {
+    for (auto &b : m_buckets)
+      b.clear();
+    m_size = 0;
+    m_last = Key{};
+  }
+
+private:
+  template <std::size_t... I> static std::array<std::pmr::vector<value_type>, Buckets> makeBuckets(std::pmr::memory_resource *mr, std::index_sequence<I...>) {
+    return {((void)I, std::pmr::vector<value_type>{mr})...};
+  }
+
+  std::size_t bucket(Key k) const { return static_cast<std::size_t>(std::bit_width(static_cast<Key>(k ^ m_last))); }
+
+  // make sure bucket 0 holds the minimum. This is a lazy redistribution, it
+  // does not change the set of entries, so it is done on const access too.
+  void pull() const {
+    if (!m_buckets[0].empty())
+      return;
+    std::size_t i = 1;
+    while (m_buckets[i].empty())
+      ++i;
+    auto &src = m_buckets[i];
+    m_last = std::ranges::min_element(src, {}, &value_type::first)->first;
+    for (auto &e : src)
+      m_buckets[bucket(e.first)].push_back(std::move(e));
+    src.clear();
+  }
+
+  mutable std::array<std::pmr::vector<value_type>, Buckets> m_buckets;
+  mutable Key m_last{};
+  std::size_t m_size{};
+};
+
+/**
+ * @class BucketQueue
+ * @brief Dial's bucket queue for small integral keys.
+ *
+ * One bucket per key in a circular array, that is grown whenever a pushed key
+ * would not fit. Push is O(1), pop walks over the empty buckets between two
+ * keys. This is the fastest choice if the difference between the smallest and
+ * the largest queued key is small, e.g. for grid weights from 1 to 9.
+ *
+ * @warning the queue is monotone: a pushed key must not be smaller than the
+ * last popped one, otherwise push() throws std::logic_error.
+ */
+template <class Key, class Value> class BucketQueue {
+  static_assert(std::integral<Key>, "the bucket queue requires integral keys");
+
+public:
+  using value_type = QueueEntry<Key, Value>;
+
+  explicit BucketQueue(std::pmr::memory_resource *mr = std::pmr::get_default_resource()) : m_buckets{mr}, m_mr{mr} { grow(16); }
+
+  void push(Key k, Value v) {
+    if (k < m_popped)
+      throw std::logic_error("BucketQueue: key is smaller than the last popped one");
+    if (m_size == 0 || k < m_cursor)
+      m_cursor = k;
+    if (m_size == 0 || m_max < k)
+      m_max = k;
+    if (static_cast<std::size_t>(m_max - m_cursor) >= m_buckets.size())
+      grow(std::bit_ceil(static_cast<std::size_t>(m_max - m_cursor) + 1));
+    m_buckets[slot(k)].push_back(value_type{k, std::move(v)});
+    ++m_size;
+  }
+
+  [[nodiscard]] const value_type &top() const {
+    advance();
+    return m_buckets[slot(m_cursor)].back();
+  }
+
+  void pop() {
+    advance();
+    m_buckets[slot(m_cursor)].pop_back();
+    m_popped = m_cursor;
+    --m_size;
+  }
+
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+  [[nodiscard]] std::size_t size() const { return m_size; }
+
+  void clear() {
+    for (auto &b : m_buckets)
+      b.clear();
+    m_size = 0;
+    m_cursor = m_max = Key{};
+    m_popped = std::numeric_limits<Key>::lowest();
+  }
+
+private:
+  std::size_t slot(Key k) const { return static_cast<std::size_t>(k) & (m_buckets.size() - 1); }
+
+  // move the cursor to the first non empty bucket
+  void advance() const {
+    while (m_buckets[slot(m_cursor)].empty())
+      ++m_cursor;
+  }
+
+  void grow(std::size_t buckets) {
+    std::pmr::vector<std::pmr::vector<value_type>> old{m_mr};
+    old.swap(m_buckets);
+    m_buckets.reserve(buckets);
+    // the buckets pick up the memory resource of the outer vector
+    m_buckets.resize(buckets);
+    for (auto &b : old)
+      for (auto &e : b)
+        m_buckets[slot(e.first)].push_back(std::move(e));
+  }
+
+  mutable std::pmr::vector<std::pmr::vector<value_type>> m_buckets;
+  std::pmr::memory_resource *m_mr;
+  mutable Key m_cursor{};
+  Key m_max{}, m_popped{std::numeric_limits<Key>::lowest()};
+  std::size_t m_size{};
+};
+
+/**
+ * @name Queue policies
+ * @brief select the priority queue of Dijkstra and GridDijkstra
+ */
+///@{
+struct BinaryHeapPolicy {
+  template <class Key, class Value> using queue = BinaryHeapQueue<Key, Value>;
+};
+
+template <std::size_t D = 4> struct DaryHeapPolicy {
+  template <class Key, class Value> using queue = DaryHeapQueue<Key, Value, D>;
+};
+
+struct RadixHeapPolicy {
+  template <class Key, class Value> using queue = RadixHeapQueue<Key, Value>;
+};
+
+struct BucketQueuePolicy {
+  template <class Key, class Value> using queue = BucketQueue<Key, Value>;
+};
+
+/** @brief radix heap for unsigned integral keys, binary heap for everything else */
+struct AutoQueuePolicy {
+  template <class Key, class Value> using queue = std::conditional_t<std::unsigned_integral<Key>, RadixHeapQueue<Key, Value>, BinaryHeapQueue<Key, Value>>;
+};
+///@}
+
+} // namespace AoC
+
+#endif // PRIORITYQUEUE_H
@@ -0,0 +1,225 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <parallel.h>
+
+#include "measure.h"
+
+namespace AoC {
+
+/**
+ * @brief expected answers per input, a missing part is not checked
+ */
+using ExpectedAnswers = std::map<std::string, std::array<std::optional<std::string>, 2>>;
+
+/**
+ * @brief the outcome of one input of a batch run
+ */
+struct BatchEntry {
+  std::string input;
+  std::array<std::optional<std::string>, 2> results;
+  std::array<std::optional<std::string>, 2> expected;
+  /// set, if the input could not be solved
+  std::optional<std::string> error;
+  /// wall time for loading, parsing and all parts
+  double ms{};
+
+  /** @brief true, if there was no error and every expected answer matches */
+  [[nodiscard]] bool passed() const {
+    if (error)
+      return false;
+    for (std::size_t i = 0; i < 2; ++i)
+      if (expected[i] && results[i] && expected[i] != results[i])
+        return false;
+    return true;
+  }
+};
+
+/**
+ * @brief read an expected answers file
+ *
+ * Every line holds an input name, followed by the answers for part 1 and part 2, separated by whitespace. A `-` skips
+ * the check of a part. Empty lines and lines starting with `#` are ignored.
+ *
+ * @throw std::runtime_error if the file can not be read
+ */
+inline ExpectedAnswers readExpected(const std::string &path) {
+  std::ifstream in{path};
+  if (!in)
+    throw std::runtime_error("failed to open expected answers " + path);
+  ExpectedAnswers out;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream fields{line};
+    std::string name;
+    if (!(fields >> name) || name.front() == '#')
+      continue;
+    auto &answers = out[name];
+    for (auto &a : answers) {
+      std::string value;
+      if (fields >> value && value != "-")
+        a = value;
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief expand a list of files and directories into the input files
+ *
+ * Directories contribute all regular files they contain directly, sorted by name. Files are taken as they are.
+ *
+ * @throw std::filesystem::filesystem_error if a directory can not be read
+ */
+inline std::vector<std::string> collectInputs(const std::vector<std::string> &paths) {
+  std::vector<std::string> out;
+  for (auto const &p : paths) {
+    if (!std::filesystem::is_directory(p)) {
+      out.push_back(p);
+      continue;
+    }
+    std::vector<std::string> files;
+    for (auto const &e : std::filesystem::directory_iterator{p})
+      if (e.is_regular_file())
+        files.push_back(e.path().string());
+    std::ranges::sort(files);
+    out.insert(out.end(), files.begin(), files.end());
+  }
+  return out;
+}
+
+/**
+ * @brief solve many inputs on a worker pool
+ *
+ * `solve(const std::string &input, BatchEntry &entry)` fills the results of one input. Exceptions are caught and
+ * recorded as the error of that input, so one bad input does not stop the batch.
+ *
+ * @param inputs the input files
+ * @param expected the expected answers, looked up by the input as given, and by its file name
+ * @param solve the solve function, called from several threads at once
+ * @param threads number of worker threads, 0 for all cores
+ * @return one entry per input, in input order
+ */
+template <typename F>
+std::vector<BatchEntry> runBatch(const std::vector<std::string> &inputs, const ExpectedAnswers &expected, F &&solve, unsigned threads = 0) {
+  std::vector<BatchEntry> entries(inputs.size());
+  parallelFor(
+      inputs.size(),
+      [&](unsigned, std::size_t i) {
+        auto &e = entries[i];
+        e.input = inputs[i];
+        auto it = expected.find(e.input);
+        if (it == expected.end())
+          it = expected.find(std::filesystem::path{e.input}.filename().string());
+        if (it != expected.end())
+          e.expected = it->second;
+
+        auto const begin = std::chrono::steady_clock::now();
+        try {
+          solve(e.input, e);
+        } catch (const std::exception &ex) {
+          e.error = ex.what();
+        } catch (...) {
+          e.error = "unknown error";
+        }
+        e.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+      },
+      threads);
+  return entries;
+}
+
+/**
+ * @brief print the outcome of a batch run, one line per input and a summary
+ * @param time include the wall time per input
+ */
+inline void printBatch(std::ostream &os, const std::vector<BatchEntry> &entries, bool time) {
+  std::size_t failed = 0;
+  for (auto const &e : entries) {
+    os << e.input << ":";
+    if (e.error) {
+      os << " error: " << *e.error;
+    } else {
+      const char *sep = " ";
+      for (std::size_t i = 0; i < 2; ++i) {
+        if (!e.results[i])
+          continue;
+        os << sep << "part " << i + 1 << " = " << *e.results[i];
+        sep = ", ";
+        if (e.expected[i] && e.expected[i] != e.results[i])
+          os << " (expected " << *e.expected[i] << ")";
+      }
+    }
+    if (time)
+      os << " [" << std::fixed << std::setprecision(3) << e.ms << " ms]" << std::defaultfloat;
+    os << (e.passed() ? "" : " FAILED") << '\n';
+    failed += !e.passed();
+  }
+  os << entries.size() << " inputs, " << failed << " failed" << std::endl;
+}
+
+/**
+ * @brief print the outcome of a batch run as a JSON array
+ */
+inline void printBatchJson(std::ostream &os, const std::vector<BatchEntry> &entries) {
+  os << "[";
+  const char *sep = "";
+  for (auto const &e : entries) {
+    os << sep << "{\"input\":";
+    writeJsonString(os, e.input);
+    for (std::size_t i = 0; i < 2; ++i) {
+      if (e.results[i]) {
+        os << ",\"part" << i + 1 << "\":";
+        writeJsonString(os, *e.results[i]);
+      }
+      if (e.expected[i]) {
+        os << ",\"expected" << i + 1 << "\":";
+        writeJsonString(os, *e.expected[i]);
+      }
+    }
+    if (e.error) {
+      os << ",\"error\":";
+      writeJsonString(os, *e.error);
+    }
+    os << ",\"ms\":" << e.ms << ",\"passed\":" << (e.passed() ? "true" : "false") << "}";
+    sep = ",";
+  }
+  os << "]" << std::endl;
+}
+
+} // namespace AoC
+
+#endif // BATCH_H
@@ -0,0 +1,243 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEASURE_H
+#define MEASURE_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace AoC {
+
+/**
+ * @brief hardware counter values of a measured section
+ */
+struct PerfSample {
+  uint64_t cycles{}, instructions{}, cacheMisses{};
+
+  PerfSample &operator+=(const PerfSample &o) {
+    cycles += o.cycles;
+    instructions += o.instructions;
+    cacheMisses += o.cacheMisses;
+    return *this;
+  }
+};
+
+/**
+ * @class PerfCounters
+ * @brief cycles, instructions and cache misses of the calling thread, read through `perf_event_open`.
+ *
+ * The counters are only available on Linux, and only if the kernel allows it (see
+ * `/proc/sys/kernel/perf_event_paranoid`). If they are not, available() is false and stop() returns zeros.
+ */
+class PerfCounters {
+public:
+  PerfCounters() {
+#if defined(__linux__)
+    constexpr std::array<uint64_t, 3> events{PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    for (std::size_t i = 0; i < events.size(); ++i) {
+      perf_event_attr attr{};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = events[i];
+      attr.disabled = i == 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      m_fd[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : m_fd[0], 0));
+      if (m_fd[i] < 0) {
+        close();
+        return;
+      }
+    }
+#endif
+  }
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  ~PerfCounters() { close(); }
+
+  /** @brief true if the counters could be opened */
+  [[nodiscard]] bool available() const { return m_fd[0] >= 0; }
+
+  /** @brief reset and start the counters */
+  void start() {
+#if defined(__linux__)
+    if (!available())
+      return;
+    ioctl(m_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+  }
+
+  /** @brief stop the counters, and read them */
+  PerfSample stop() {
+#if defined(__linux__)
+    if (!available())
+      return {};
+    ioctl(m_fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    // PERF_FORMAT_GROUP: the number of events, followed by their values
+    std::array<uint64_t, 4> values{};
+    if (read(m_fd[0], values.data(), sizeof(values)) != static_cast<ssize_t>(sizeof(values)))
+      return {};
+    return {values[1], values[2], values[3]};
+#else
+    return {};
+#endif
+  }
+
+private:
+  void close() {
+#if defined(__linux__)
+    for (auto &fd : m_fd)
+      if (fd >= 0)
+        ::close(std::exchange(fd, -1));
+#endif
+  }
+
+  std::array<int, 3> m_fd{-1, -1, -1};
+};
+
+/**
+ * @brief the peak resident set size of the process in KiB, or 0 where `getrusage` is not available
+ */
+inline long peakRssKiB() {
+#if __has_include(<sys/resource.h>)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @class Phase
+ * @brief wall time samples and counters of one phase of a puzzle run, e.g. "parse" or "part 1"
+ */
+class Phase {
+public:
+  explicit Phase(std::string name) : m_name{std::move(name)} {}
+
+  /**
+   * @brief run and measure `f()`
+   * @param perf counters to sample, or nullptr
+   * @return the result of `f()`
+   */
+  template <typename F> decltype(auto) measure(PerfCounters *perf, F &&f) {
+    struct Stop {
+      Phase &phase;
+      PerfCounters *perf;
+      std::chrono::steady_clock::time_point begin{std::chrono::steady_clock::now()};
+
+      ~Stop() {
+        auto const end = std::chrono::steady_clock::now();
+        if (perf)
+          phase.m_perf += perf->stop();
+        phase.m_samples.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+      }
+    };
+    if (perf)
+      perf->start();
+    Stop stop{*this, perf};
+    return f();
+  }
+
+  [[nodiscard]] const std::string &name() const { return m_name; }
+  [[nodiscard]] std::size_t runs() const { return m_samples.size(); }
+
+  /** @brief fastest run in milliseconds */
+  [[nodiscard]] double min() const { return m_samples.empty() ? 0 : *std::ranges::min_element(m_samples); }
+
+  /** @brief median of all runs in milliseconds */
+  [[nodiscard]] double median() const {
+    if (m_samples.empty())
+      return 0;
+    auto s = m_samples;
+    std::ranges::sort(s);
+    auto const mid = s.size() / 2;
+    return s.size() % 2 ? s[mid] : (s[mid - 1] + s[mid]) / 2;
+  }
+
+  /** @brief counters, averaged over all runs */
+  [[nodiscard]] PerfSample perf() const {
+    auto const n = std::max<std::size_t>(m_samples.size(), 1);
+    return {m_perf.cycles / n, m_perf.instructions / n, m_perf.cacheMisses / n};
+  }
+
+private:
+  std::string m_name;
+  std::vector<double> m_samples;
+  PerfSample m_perf;
+};
+
+/**
+ * @brief write a string as JSON string literal
+ */
+inline void writeJsonString(std::ostream &os, std::string_view s) {
+  os << '"';
+  for (char c : s) {
+    switch (c) {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    case '\n':
+      os << "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+      else
+        os << c;
+    }
+  }
+  os << '"';
+}
+
+} // namespace AoC
+
+#endif // MEASURE_H
@@ -20,12 +20,22 @@
 #ifndef PUZZLE_H
 #define PUZZLE_H
 
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <string_view>
 #include <utility>
 
 #include <cxxopts.hpp>
+#include <inputSource.h>
+
+#include "batch.h"
+#include "measure.h"
 
 /**
  * @macro PUZZLE_MAIN
@@ -49,17 +59,236 @@ namespace AoC {
  * @brief Requirements for a AoC puzzle.
  *
  * A Puzzle requires the following functions:
- * - Constructor that takes and std::istream reference
+ * - Constructor that takes and std::istream reference OR a std::string_view
  * - a `Part1()` function
  * - a `Part2()` function
+ *
+ * Puzzles that take a std::string_view get the memory mapped input file, without any stream in between. Stream based
+ * puzzles read from a stream buffer over the same mapping. See InputSource.
+ */
+template <class T>
+concept Puzzle = (std::constructible_from<T, std::istream &> || std::constructible_from<T, std::string_view>)&&requires(T t) {
+  t.Part1();
+  t.Part2();
+};
+
+/**
+ * @concept ConstParts
+ *
+ * @brief Fulfilled if `Part1()` and `Part2()` can be called on a const Puzzle.
+ *
+ * Const parts are expected to be safe to run at the same time on the same
+ * object.
  */
 template <class T>
-concept Puzzle = requires(T t) {
-  std::constructible_from<T,std::istream&>;
+concept ConstParts = requires(const T t) {
   t.Part1();
   t.Part2();
 };
 
+/**
+ * @concept ConcurrentParts
+ *
+ * @brief Fulfilled if the parts of a Puzzle can run at the same time: either
+ * they are const, or the Puzzle can be copied, so every part gets its own
+ * object.
+ */
+template <class T>
+concept ConcurrentParts = Puzzle<T> && (ConstParts<T> || std::copy_constructible<T>);
+
+/**
+ * @class PuzzleReport
+ * @brief results and measurements of the runs of a Puzzle
+ */
+class PuzzleReport {
+public:
+  PuzzleReport() : m_phases{Phase{"load"}, Phase{"parse"}, Phase{"part1"}, Phase{"part2"}} {}
+
+  ///@{
+  /** @brief the measured phases */
+  Phase &load() { return m_phases[0]; }
+  Phase &parse() { return m_phases[1]; }
+  Phase &part(int n) { return m_phases[static_cast<std::size_t>(1 + n)]; }
+  ///@}
+
+  /** @brief the result of a part, as printed */
+  std::string &result(int n) { return m_results[static_cast<std::size_t>(n - 1)]; }
+
+  /**
+   * @brief print the measurements as table
+   * @param perf include the hardware counters
+   */
+  void print(std::ostream &os, bool perf) const {
+    auto const flags = os.flags();
+    os << std::fixed << std::setprecision(3) << "timing (" << m_phases[0].runs() << " runs)        min ms   median ms";
+    if (perf)
+      os << "        cycles  instructions  cache misses";
+    os << '\n';
+    for (auto const &p : m_phases) {
+      if (p.runs() == 0)
+        continue;
+      os << "  " << std::left << std::setw(12) << p.name() << std::right << std::setw(14) << p.min() << std::setw(12) << p.median();
+      if (perf)
+        os << std::setw(14) << p.perf().cycles << std::setw(14) << p.perf().instructions << std::setw(14) << p.perf().cacheMisses;
+      os << '\n';
+    }
+    os << "peak RSS: " << peakRssKiB() << " KiB" << std::endl;
+    os.flags(flags);
+  }
+
+  /**
+   * @brief print the results and measurements as a JSON object
+   * @param perf include the hardware counters
+   */
+  void printJson(std::ostream &os, int year, int day, bool perf) const {
+    os << "{\"year\":" << year << ",\"day\":" << day << ",\"results\":{";
+    const char *sep = "";
+    for (int n = 1; n <= 2; ++n) {
+      if (m_phases[static_cast<std::size_t>(1 + n)].runs() == 0)
+        continue;
+      os << sep << "\"part" << n << "\":";
+      writeJsonString(os, m_results[static_cast<std::size_t>(n - 1)]);
+      sep = ",";
+    }
+    os << "},\"runs\":" << m_phases[0].runs() << ",\"timing\":{";
+    sep = "";
+    for (auto const &p : m_phases) {
+      if (p.runs() == 0)
+        continue;
+      os << sep;
+      writeJsonString(os, p.name());
+      os << ":{\"min_ms\":" << p.min() << ",\"median_ms\":" << p.median();
+      if (perf)
+        os << ",\"cycles\":" << p.perf().cycles << ",\"instructions\":" << p.perf().instructions << ",\"cache_misses\":" << p.perf().cacheMisses;
+      os << "}";
+      sep = ",";
+    }
+    os << "},\"peak_rss_kib\":" << peakRssKiB() << "}" << std::endl;
+  }
+
+private:
+  std::array<Phase, 4> m_phases;
+  std::array<std::string, 2> m_results;
+};
+
+/**
+ * @brief runs the parts of a Puzzle, as selected on the command line
+ *
+ * @param puzzle the puzzle
+ * @param opts the parsed command line
+ * @param report receives the results and timings
+ * @param perf hardware counters to sample, or nullptr
+ * @param verbose print the progress and the results
+ * @param parallel run part 1 and part 2 at the same time, if both are selected. This needs a Puzzle with
+ *   ConcurrentParts: const parts share the puzzle object, otherwise part 2 runs on a copy. For other puzzles, and if
+ *   only one part is selected, the parts run one after the other. Hardware counters are not sampled in parallel runs,
+ *   as they only see the calling thread.
+ */
+template <Puzzle P>
+void runParts(P &puzzle, const cxxopts::ParseResult &opts, PuzzleReport &report, PerfCounters *perf, bool verbose, bool parallel = false) {
+  auto measure = [&report](int n, PerfCounters *counters, auto &&part) {
+    auto const res = report.part(n).measure(counters, part);
+    std::ostringstream out;
+    out << res;
+    report.result(n) = out.str();
+  };
+  auto printResult = [&](int n) {
+    if (verbose)
+      std::cout << "part " << n << " result: " << report.result(n) << std::endl;
+  };
+
+  if constexpr (ConcurrentParts<P>) {
+    if (parallel && opts.count("part1") && opts.count("part2")) {
+      if (verbose)
+        std::cout << "running part 1 and 2 in parallel ..." << std::endl;
+      // the counters only see the calling thread, so they are not used here
+      auto concurrently = [&](auto &first, auto &second) {
+        auto part2 = std::async(std::launch::async, [&] { measure(2, nullptr, [&second] { return second.Part2(); }); });
+        measure(1, nullptr, [&first] { return first.Part1(); });
+        part2.get();
+      };
+      // const parts share the puzzle, otherwise part 2 works on a copy
+      if constexpr (ConstParts<P>) {
+        concurrently(std::as_const(puzzle), std::as_const(puzzle));
+      } else {
+        P copy{puzzle};
+        concurrently(puzzle, copy);
+      }
+      printResult(1);
+      printResult(2);
+      return;
+    }
+  }
+
+  if (opts.count("part1")) {
+    if (verbose)
+      std::cout << "running part 1 ..." << std::endl;
+    measure(1, perf, [&puzzle] { return puzzle.Part1(); });
+    printResult(1);
+  }
+
+  if (opts.count("part2")) {
+    if (verbose)
+      std::cout << "running part 2 ..." << std::endl;
+    measure(2, perf, [&puzzle] { return puzzle.Part2(); });
+    printResult(2);
+  }
+}
+
+/**
+ * @brief solve all inputs given with `--batch`
+ *
+ * Every input gets its own Puzzle object, the inputs are spread over a worker
+ * pool. Puzzles must not share mutable state between objects.
+ *
+ * @return 0 if all inputs were solved and matched the expected answers
+ */
+template <Puzzle P>
+int runPuzzleBatch(const cxxopts::ParseResult &opts, bool json) {
+  std::vector<std::string> inputs;
+  ExpectedAnswers expected;
+  try {
+    inputs = collectInputs(opts["batch"].as<std::vector<std::string>>());
+    if (opts.count("expected"))
+      expected = readExpected(opts["expected"].as<std::string>());
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  auto const part1 = opts.count("part1") != 0, part2 = opts.count("part2") != 0;
+  auto solveParts = [&](P &puzzle, BatchEntry &entry) {
+    auto store = [](auto const &res, std::optional<std::string> &out) {
+      std::ostringstream s;
+      s << res;
+      out = s.str();
+    };
+    if (part1)
+      store(puzzle.Part1(), entry.results[0]);
+    if (part2)
+      store(puzzle.Part2(), entry.results[1]);
+  };
+
+  auto entries = runBatch(
+      inputs, expected,
+      [&](const std::string &filename, BatchEntry &entry) {
+        InputSource input{filename};
+        if constexpr (std::constructible_from<P, std::string_view>) {
+          P puzzle(input.view());
+          solveParts(puzzle, entry);
+        } else {
+          P puzzle(input.stream());
+          solveParts(puzzle, entry);
+        }
+      },
+      opts["threads"].as<unsigned>());
+
+  if (json)
+    printBatchJson(std::cout, entries);
+  else
+    printBatch(std::cout, entries, opts.count("time") != 0);
+  return std::ranges::all_of(entries, &BatchEntry::passed) ? 0 : 1;
+}
 
 /**
  * @brief runs a Puzzle.
@@ -67,6 +296,18 @@ concept Puzzle = requires(T t) {
  * This function is called from main, and does all the handling of input
  * parameters, class instantiation and actually running the Puzzle
  *
+ * With `--time`, loading the input, the constructor (parsing) and every part
+ * are timed, and the minimum and median over `--repeat` runs are printed,
+ * together with the peak RSS. Every repeat constructs a fresh puzzle, so parts
+ * that modify the puzzle are measured correctly. `--perf` adds hardware
+ * counters, and `--json` prints everything as one JSON object instead.
+ *
+ * With `--parallel`, both parts run at the same time on two threads, if the
+ * Puzzle fulfills ConcurrentParts. The results are printed in order, after
+ * both parts finished. Hardware counters are not sampled in this mode.
+ *
+ * With `--batch`, many inputs are solved in one process, see runPuzzleBatch().
+ *
  * @tparam P the Puzzle object type
  * @param year the AoC year
  * @param day the AoC day
@@ -86,10 +327,18 @@ int runPuzzle(int year, int day, int argc, char *argv[]) {
 
   // clang-format off
   options.add_options()
-      ("f,file",  "File name",  cxxopts::value<std::string>()->default_value("input.txt"))
-      ("1,part1", "Run Part 1")
-      ("2,part2", "Run Part 2")
-      ("h,help",  "Print usage")
+      ("f,file",   "File name, - for stdin",  cxxopts::value<std::string>()->default_value("input.txt"))
+      ("1,part1",  "Run Part 1")
+      ("2,part2",  "Run Part 2")
+      ("t,time",   "Report the time for loading, parsing and each part, and the peak memory")
+      ("r,repeat", "Run everything N times, and report the minimum and median times", cxxopts::value<unsigned>()->default_value("1"))
+      ("json",     "Print the results and measurements as JSON")
+      ("perf",     "Add hardware counters (cycles, instructions, cache misses) to the report, if available")
+      ("p,parallel", "Run Part 1 and Part 2 at the same time, if the puzzle allows it")
+      ("b,batch",  "Solve many input files or directories in one process", cxxopts::value<std::vector<std::string>>())
+      ("expected", "File with the expected answers for --batch: <input> <part 1> <part 2> per line", cxxopts::value<std::string>())
+      ("j,threads", "Number of worker threads for --batch, 0 for all cores", cxxopts::value<unsigned>()->default_value("0"))
+      ("h,help",   "Print usage")
   ;
   // clang-format on
   auto opts = options.parse(argc, argv);
@@ -98,25 +347,57 @@ int runPuzzle(int year, int day, int argc, char *argv[]) {
     std::exit(0);
   }
 
+  auto const json = opts.count("json") != 0;
+  if (opts.count("batch"))
+    return runPuzzleBatch<P>(opts, json);
+
   auto const filename = opts["file"].as<std::string>();
-  std::ifstream input{filename};
-  if (!input) {
-    std::cerr << "failed to open input file " << filename << std::endl;
-    std::exit(1);
+  auto repeat = std::max(opts["repeat"].as<unsigned>(), 1u);
+  if (filename == "-" && repeat > 1) {
+    std::cerr << "stdin can only be read once, --repeat is ignored" << std::endl;
+    repeat = 1;
   }
-
-  P puzzle(input);
-  if (opts.count("part1")) {
-    std::cout << "running part 1 ..." << std::endl;
-    auto const res = puzzle.Part1();
-    std::cout << "part 1 result: " << res << std::endl;
+  auto const parallel = opts.count("parallel") != 0;
+  if constexpr (!ConcurrentParts<P>) {
+    if (parallel)
+      std::cerr << "the parts of this puzzle can not run in parallel, running them one after the other" << std::endl;
   }
 
-  if (opts.count("part2")) {
-    std::cout << "running part 2 ..." << std::endl;
-    auto const res = puzzle.Part2();
-    std::cout << "part 2 result: " << res << std::endl;
+  PuzzleReport report;
+  std::optional<PerfCounters> counters;
+  if (opts.count("perf"))
+    counters.emplace();
+  PerfCounters *perf = counters && counters->available() ? &*counters : nullptr;
+  if (counters && !perf)
+    std::cerr << "hardware counters are not available" << std::endl;
+
+  for (unsigned r = 0; r < repeat; ++r) {
+    auto const verbose = !json && r == 0;
+    std::optional<InputSource> input;
+    report.load().measure(perf, [&] {
+      try {
+        input.emplace(filename);
+        // inputs that can not be mapped are read completely while loading
+        if constexpr (std::constructible_from<P, std::string_view>)
+          input->view();
+      } catch (const std::system_error &e) {
+        std::cerr << "failed to open input file " << filename << ": " << e.code().message() << std::endl;
+        std::exit(1);
+      }
+    });
+
+    std::optional<P> puzzle;
+    if constexpr (std::constructible_from<P, std::string_view>)
+      report.parse().measure(perf, [&] { puzzle.emplace(input->view()); });
+    else
+      report.parse().measure(perf, [&] { puzzle.emplace(input->stream()); });
+    runParts(*puzzle, opts, report, perf, verbose, parallel);
   }
+
+  if (json)
+    report.printJson(std::cout, year, day, perf != nullptr);
+  else if (opts.count("time") || repeat > 1 || perf)
+    report.print(std::cout, perf != nullptr);
   return 0;
 }
 
@@ -0,0 +1,299 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATON_H
+#define AUTOMATON_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "numericGrid.h"
+#include "paddedGrid.h"
+#include "parallel.h"
+#include "stencil.h"
+
+namespace AoC {
+
+/**
+ * @class Automaton
+ * @brief step engine for cellular automata on a numeric grid.
+ *
+ * The automaton holds the current generation and the next one in two padded buffers. A step evaluates a local rule for
+ * every cell into the next buffer, and swaps both buffers afterwards, so no grid is ever copied. The rule has the same
+ * form as for paddedGrid::apply(): `T rule(const T &cell, const std::array<T, N> &neighbours)`, neighbours outside of the
+ * grid read as the border value.
+ *
+ * Large grids are split into blocks of rows, that are evaluated on sharedPool(). With an explicit thread count set by
+ * setThreads(), the automaton starts its own WorkerPool with the first parallel step instead, and keeps it for all
+ * following ones. The rule is then called from several threads at once, and must not modify shared state.
+ *
+ * With the active set enabled, only cells that changed in the last step and the cells that see them through the
+ * stencil are evaluated. This pays off once the automaton settles, and most of the grid stays the same.
+ *
+ * @tparam T the storage type for each cell
+ */
+template <typename T = uint_fast8_t> class Automaton {
+public:
+  /// grids with less cells are always stepped on the calling thread
+  static constexpr std::size_t MinParallelCells = std::size_t{1} << 16;
+  /// approximate number of cells per work item
+  static constexpr std::size_t BlockCells = std::size_t{1} << 14;
+
+  /**
+   * @brief Constructor.
+   *
+   * @param grid the first generation
+   * @param border the value of all cells outside of the grid
+   * @param padding the width of the border, has to cover the reach of all stencils used
+   */
+  explicit Automaton(const numericGrid<T> &grid, T border = {}, std::size_t padding = 1) : m_current{grid, border, padding}, m_next{m_current} {}
+
+  /**
+   * @brief set the number of threads for large grids
+   * @param threads number of threads, 0 to use sharedPool()
+   */
+  void setThreads(unsigned threads) {
+    if (threads != m_threads)
+      m_pool.reset();
+    m_threads = threads;
+  }
+
+  /**
+   * @brief restrict the work of each step to the cells, that might change
+   *
+   * The first step after enabling still evaluates the whole grid, to find the changed cells.
+   */
+  void enableActiveSet(bool enable = true) {
+    m_active = enable;
+    m_tracked = false;
+  }
+
+  /**
+   * @brief advance by one generation
+   *
+   * @param stencil the neighbours passed to the rule
+   * @param rule the cell function
+   * @return the number of cells, that changed
+   * @throws std::invalid_argument if the stencil reaches further than the padding
+   */
+  template <std::size_t N, typename Rule> std::size_t step(const Stencil<N> &stencil, Rule &&rule) {
+    if (stencilReach(stencil) > m_current.padding())
+      throw std::invalid_argument("Automaton: stencil reaches beyond the padding");
+    auto const offs = m_current.offsets(stencil);
+
+    std::size_t changed;
+    if (m_active && m_tracked)
+      changed = stepActive(offs, rule);
+    else
+      changed = stepAll(offs, rule);
+
+    std::swap(m_current, m_next);
+    m_tracked = m_active;
+    ++m_generation;
+    return changed;
+  }
+
+  /**
+   * @brief advance until nothing changes anymore, or a number of steps is done
+   *
+   * @param stencil the neighbours passed to the rule
+   * @param rule the cell function
+   * @param maxSteps the maximum number of steps
+   * @return the number of steps done. If a fixed point was reached, the last of them changed nothing.
+   */
+  template <std::size_t N, typename Rule>
+  std::size_t run(const Stencil<N> &stencil, Rule &&rule, std::size_t maxSteps = std::numeric_limits<std::size_t>::max()) {
+    std::size_t steps = 0;
+    while (steps < maxSteps) {
+      ++steps;
+      if (step(stencil, rule) == 0)
+        break;
+    }
+    return steps;
+  }
+
+  /** @brief get a cell of the current generation */
+  const T &operator[](const std::pair<std::size_t, std::size_t> &idx) const {
+    return m_current[{static_cast<std::ptrdiff_t>(idx.first), static_cast<std::ptrdiff_t>(idx.second)}];
+  }
+
+  /** @brief the current generation, including its border */
+  [[nodiscard]] const paddedGrid<T> &current() const { return m_current; }
+
+  /** @brief copy the current generation into a numericGrid */
+  [[nodiscard]] numericGrid<T> grid() const { return m_current.toGrid(); }
+
+  /** @brief the number of steps done since construction */
+  [[nodiscard]] std::size_t generation() const { return m_generation; }
+
+private:
+  /// evaluate one cell, true if it changed
+  template <std::size_t N, typename Rule> bool update(std::size_t idx, const std::array<std::ptrdiff_t, N> &offs, Rule &rule) {
+    const T *cell = m_current.data() + idx;
+    std::array<T, N> n;
+    for (std::size_t i = 0; i < N; ++i)
+      n[i] = cell[offs[i]];
+    T const v = rule(*cell, n);
+    m_next.data()[idx] = v;
+    return v != *cell;
+  }
+
+  [[nodiscard]] unsigned threadsFor(std::size_t cells) const { return cells < MinParallelCells ? 1 : m_threads; }
+
+  /// run `fn(worker, block)` for every block, on the pool if there is more than one worker
+  template <typename F> void parallelBlocks(std::size_t blocks, unsigned threads, F &&fn) {
+    if (workerCount(blocks, threads) == 1) {
+      for (std::size_t b = 0; b < blocks; ++b)
+        fn(0u, b);
+      return;
+    }
+    if (m_threads == 0) {
+      sharedPool().parallelFor(blocks, fn, threads);
+      return;
+    }
+    if (!m_pool)
+      m_pool = std::make_unique<WorkerPool>(m_threads);
+    m_pool->parallelFor(blocks, fn, threads);
+  }
+
+  /// prepare one list of changed cells per worker, if they are tracked
+  void resetWorkers(unsigned workers) {
+    m_workerChanged.resize(std::max<std::size_t>(m_workerChanged.size(), workers));
+    for (auto &c : m_workerChanged)
+      c.clear();
+    m_workerCount.assign(workers, 0);
+  }
+
+  /// gather the changed cells of all workers
+  std::size_t collect() {
+    std::size_t changed = 0;
+    for (auto c : m_workerCount)
+      changed += c;
+    if (m_active) {
+      m_changed.clear();
+      for (auto const &c : m_workerChanged)
+        m_changed.insert(m_changed.end(), c.begin(), c.end());
+    }
+    return changed;
+  }
+
+  template <std::size_t N, typename Rule> std::size_t stepAll(const std::array<std::ptrdiff_t, N> &offs, Rule &rule) {
+    auto const rows = m_current.rows(), columns = m_current.columns();
+    auto const rowsPerBlock = std::max<std::size_t>(1, BlockCells / std::max<std::size_t>(columns, 1));
+    auto const blocks = (rows + rowsPerBlock - 1) / rowsPerBlock;
+    auto const threads = threadsFor(rows * columns);
+    resetWorkers(workerCount(blocks, threads));
+
+    parallelBlocks(
+        blocks, threads,
+        [&](unsigned worker, std::size_t b) {
+          std::size_t changed = 0;
+          auto &list = m_workerChanged[worker];
+          for (std::size_t y = b * rowsPerBlock; y < std::min(rows, (b + 1) * rowsPerBlock); ++y) {
+            auto const base = m_current.index({0, static_cast<std::ptrdiff_t>(y)});
+            for (std::size_t x = 0; x < columns; ++x) {
+              if (update(base + x, offs, rule)) {
+                ++changed;
+                if (m_active)
+                  list.push_back(base + x);
+              }
+            }
+          }
+          m_workerCount[worker] += changed;
+        });
+    return collect();
+  }
+
+  template <std::size_t N, typename Rule> std::size_t stepActive(const std::array<std::ptrdiff_t, N> &offs, Rule &rule) {
+    // the next buffer still holds the generation before the current one, it differs exactly in the changed cells
+    for (auto idx : m_changed)
+      m_next.data()[idx] = m_current.data()[idx];
+
+    // every cell, that has a changed cell as neighbour, has to be evaluated again
+    if (m_stamp.empty())
+      m_stamp.assign(m_current.stride() * (m_current.rows() + 2 * m_current.padding()), 0);
+    if (++m_epoch == 0) {
+      std::ranges::fill(m_stamp, 0);
+      m_epoch = 1;
+    }
+    m_candidates.clear();
+    auto visit = [this](std::size_t idx) {
+      if (m_stamp[idx] != m_epoch && inside(idx)) {
+        m_stamp[idx] = m_epoch;
+        m_candidates.push_back(idx);
+      }
+    };
+    for (auto idx : m_changed) {
+      visit(idx);
+      for (auto o : offs)
+        visit(static_cast<std::size_t>(static_cast<std::ptrdiff_t>(idx) - o));
+    }
+
+    auto const blocks = (m_candidates.size() + BlockCells - 1) / BlockCells;
+    auto const threads = threadsFor(m_candidates.size());
+    resetWorkers(workerCount(blocks, threads));
+    parallelBlocks(
+        blocks, threads,
+        [&](unsigned worker, std::size_t b) {
+          std::size_t changed = 0;
+          auto &list = m_workerChanged[worker];
+          for (std::size_t i = b * BlockCells; i < std::min(m_candidates.size(), (b + 1) * BlockCells); ++i) {
+            if (update(m_candidates[i], offs, rule)) {
+              ++changed;
+              list.push_back(m_candidates[i]);
+            }
+          }
+          m_workerCount[worker] += changed;
+        });
+    return collect();
+  }
+
+  /// true if a buffer index is inside the grid, and not part of the border
+  [[nodiscard]] bool inside(std::size_t idx) const {
+    auto const pad = m_current.padding();
+    auto const x = idx % m_current.stride(), y = idx / m_current.stride();
+    return x >= pad && y >= pad && x < pad + m_current.columns() && y < pad + m_current.rows();
+  }
+
+  paddedGrid<T> m_current, m_next;
+  unsigned m_threads{0};
+  std::size_t m_generation{};
+
+  // active set
+  bool m_active{false}, m_tracked{false};
+  std::vector<std::size_t> m_changed, m_candidates;
+  std::vector<uint32_t> m_stamp;
+  uint32_t m_epoch{};
+
+  std::vector<std::vector<std::size_t>> m_workerChanged;
+  std::vector<std::size_t> m_workerCount;
+  // only used with an explicit thread count
+  std::unique_ptr<WorkerPool> m_pool;
+};
+
+} // namespace AoC
+
+#endif // AUTOMATON_H
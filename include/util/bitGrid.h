@@ -0,0 +1,327 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BITGRID_H
+#define BITGRID_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "numericGrid.h"
+#include "stencil.h"
+
+namespace AoC {
+
+/**
+ * @brief a grid of single bits, for masks like "visited", "flashed" or "lit".
+ *
+ * Each row is stored in 64 bit words, column `x` is bit `x % 64` of word `x / 64`. The unused bits at the end of each
+ * row are always zero. Whole grid operations work on full words, so they handle 64 cells per instruction: logical
+ * operations between two grids, counting with popcount, and shifting the grid to build neighbour masks.
+ *
+ * Single cells are accessed through a proxy reference.
+ */
+class bitGrid {
+public:
+  using word_type = std::uint64_t;
+  static constexpr std::size_t WordBits = 64;
+
+  /**
+   * @brief proxy for a single bit of the grid
+   */
+  class reference {
+  public:
+    reference(word_type *word, word_type mask) : m_word{word}, m_mask{mask} {}
+
+    operator bool() const { return (*m_word & m_mask) != 0; }
+
+    reference &operator=(bool v) {
+      if (v)
+        *m_word |= m_mask;
+      else
+        *m_word &= ~m_mask;
+      return *this;
+    }
+    reference &operator=(const reference &other) { return *this = static_cast<bool>(other); }
+
+    /** @brief invert the bit */
+    void flip() { *m_word ^= m_mask; }
+
+  private:
+    word_type *m_word;
+    word_type m_mask;
+  };
+
+  bitGrid() = default;
+
+  /**
+   * @brief create a grid with a fixed size
+   * @param rows number of rows (y)
+   * @param columns number of columns (x)
+   * @param value initial value of each cell
+   */
+  bitGrid(std::size_t rows, std::size_t columns, bool value = false)
+      : m_rows{rows}, m_columns{columns}, m_stride{(columns + WordBits - 1) / WordBits}, m_words(rows * m_stride) {
+    fill(value);
+  }
+
+  /**
+   * @brief create a mask of all cells of a grid matching a predicate
+   */
+  template <typename T, typename Pred> bitGrid(const numericGrid<T> &grid, Pred &&pred) : bitGrid(grid.rows(), grid.columns()) {
+    for (std::size_t y = 0; y < m_rows; ++y) {
+      auto src = grid[y];
+      auto *row = m_words.data() + y * m_stride;
+      for (std::size_t x = 0; x < m_columns; ++x)
+        row[x / WordBits] |= static_cast<word_type>(static_cast<bool>(pred(src[x]))) << (x % WordBits);
+    }
+  }
+
+  /**
+   * @brief create a grid from a buffer holding the whole input, like `#..#.`
+   *
+   * Empty lines and `\r` line endings are ignored.
+   *
+   * @param input the raw puzzle input
+   * @param set the character of a set cell, every other character is a cleared cell
+   * @throws std::invalid_argument if the rows differ in length
+   */
+  static bitGrid fromString(std::string_view input, char set = '#') {
+    std::vector<std::string_view> lines;
+    while (!input.empty()) {
+      auto eol = input.find('\n');
+      auto line = input.substr(0, eol);
+      input.remove_prefix(eol == std::string_view::npos ? input.size() : eol + 1);
+      if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+      if (line.empty())
+        continue;
+      if (!lines.empty() && line.size() != lines.front().size())
+        throw std::invalid_argument("bitGrid: rows differ in length");
+      lines.push_back(line);
+    }
+
+    bitGrid grid(lines.size(), lines.empty() ? 0 : lines.front().size());
+    for (std::size_t y = 0; y < lines.size(); ++y) {
+      auto *row = grid.m_words.data() + y * grid.m_stride;
+      for (std::size_t x = 0; x < grid.m_columns; ++x)
+        row[x / WordBits] |= static_cast<word_type>(lines[y][x] == set) << (x % WordBits);
+    }
+    return grid;
+  }
+
+  ///@{
+  /**
+   * @brief get a cell by position
+   * @param idx a pair of x,y
+   */
+  reference operator[](const std::pair<std::size_t, std::size_t> &idx) {
+    return {m_words.data() + idx.second * m_stride + idx.first / WordBits, word_type{1} << (idx.first % WordBits)};
+  }
+  bool operator[](const std::pair<std::size_t, std::size_t> &idx) const { return test(idx.first, idx.second); }
+  ///@}
+
+  /** @brief true if the cell is set */
+  [[nodiscard]] bool test(std::size_t x, std::size_t y) const { return (m_words[y * m_stride + x / WordBits] >> (x % WordBits)) & 1; }
+
+  /** @brief set or clear a cell */
+  void set(std::size_t x, std::size_t y, bool v = true) { (*this)[{x, y}] = v; }
+
+  ///@{
+  /**
+   * @brief the words of a row
+   */
+  std::span<word_type> row(std::size_t y) { return {m_words.data() + y * m_stride, m_stride}; }
+  std::span<const word_type> row(std::size_t y) const { return {m_words.data() + y * m_stride, m_stride}; }
+  ///@}
+
+  ///@{
+  /**
+   * @brief all words of the grid, row by row
+   */
+  std::span<word_type> words() { return m_words; }
+  std::span<const word_type> words() const { return m_words; }
+  ///@}
+
+  /** @brief set or clear all cells */
+  void fill(bool v) {
+    std::ranges::fill(m_words, v ? ~word_type{} : word_type{});
+    maskTail();
+  }
+
+  /** @brief number of set cells */
+  [[nodiscard]] std::size_t count() const {
+    std::size_t n = 0;
+    for (auto w : m_words)
+      n += static_cast<std::size_t>(std::popcount(w));
+    return n;
+  }
+
+  /** @brief true if any cell is set */
+  [[nodiscard]] bool any() const {
+    return std::ranges::any_of(m_words, [](word_type w) { return w != 0; });
+  }
+
+  /** @brief true if no cell is set */
+  [[nodiscard]] bool none() const { return !any(); }
+
+  ///@{
+  /**
+   * @brief combine two grids of the same size, cell by cell
+   * @throws std::invalid_argument if the sizes differ
+   */
+  bitGrid &operator&=(const bitGrid &other) {
+    combine(other, [](word_type a, word_type b) { return a & b; });
+    return *this;
+  }
+  bitGrid &operator|=(const bitGrid &other) {
+    combine(other, [](word_type a, word_type b) { return a | b; });
+    return *this;
+  }
+  bitGrid &operator^=(const bitGrid &other) {
+    combine(other, [](word_type a, word_type b) { return a ^ b; });
+    return *this;
+  }
+  /** @brief clear all cells that are set in `other` */
+  bitGrid &andNot(const bitGrid &other) {
+    combine(other, [](word_type a, word_type b) { return a & ~b; });
+    return *this;
+  }
+
+  friend bitGrid operator&(bitGrid a, const bitGrid &b) { return a &= b; }
+  friend bitGrid operator|(bitGrid a, const bitGrid &b) { return a |= b; }
+  friend bitGrid operator^(bitGrid a, const bitGrid &b) { return a ^= b; }
+  ///@}
+
+  /** @brief invert every cell */
+  bitGrid &flip() {
+    for (auto &w : m_words)
+      w = ~w;
+    maskTail();
+    return *this;
+  }
+
+  friend bitGrid operator~(bitGrid a) { return a.flip(); }
+
+  /**
+   * @brief move the whole grid by an offset
+   *
+   * Cell `(x, y)` of the result is cell `(x - dx, y - dy)` of this grid, cells moved in from outside are cleared.
+   */
+  [[nodiscard]] bitGrid shifted(std::ptrdiff_t dx, std::ptrdiff_t dy) const {
+    bitGrid out(m_rows, m_columns);
+    auto const rows = static_cast<std::ptrdiff_t>(m_rows);
+    for (std::ptrdiff_t y = std::max<std::ptrdiff_t>(dy, 0); y < std::min(rows, rows + dy); ++y)
+      shiftRow(m_words.data() + static_cast<std::size_t>(y - dy) * m_stride, out.m_words.data() + static_cast<std::size_t>(y) * m_stride, dx);
+    out.maskTail();
+    return out;
+  }
+
+  /**
+   * @brief the mask of all cells, that have at least one set neighbour
+   *
+   * Built from one shift per stencil offset, so it costs a few word operations per 64 cells.
+   */
+  template <std::size_t N> [[nodiscard]] bitGrid neighbours(const Stencil<N> &stencil) const {
+    bitGrid out(m_rows, m_columns);
+    for (auto [dx, dy] : stencil)
+      out |= shifted(-dx, -dy);
+    return out;
+  }
+
+  /**
+   * @brief invoke `f(x, y)` for every set cell, in row-major order
+   */
+  template <typename F> void forEachSet(F &&f) const {
+    for (std::size_t y = 0; y < m_rows; ++y) {
+      auto const *row = m_words.data() + y * m_stride;
+      for (std::size_t i = 0; i < m_stride; ++i)
+        for (auto w = row[i]; w != 0; w &= w - 1)
+          f(i * WordBits + static_cast<std::size_t>(std::countr_zero(w)), y);
+    }
+  }
+
+  /** @brief get the number of cells */
+  [[nodiscard]] std::size_t size() const { return m_rows * m_columns; }
+
+  /** @brief get the number of rows (y) */
+  [[nodiscard]] std::size_t rows() const { return m_rows; }
+
+  /** @brief get the number of columns (x) */
+  [[nodiscard]] std::size_t columns() const { return m_columns; }
+
+  /** @brief the number of words per row */
+  [[nodiscard]] std::size_t stride() const { return m_stride; }
+
+  bool operator==(const bitGrid &) const = default;
+
+private:
+  template <typename Op> void combine(const bitGrid &other, Op op) {
+    if (other.m_rows != m_rows || other.m_columns != m_columns)
+      throw std::invalid_argument("bitGrid: sizes differ");
+    for (std::size_t i = 0; i < m_words.size(); ++i)
+      m_words[i] = op(m_words[i], other.m_words[i]);
+  }
+
+  /// out[x] = in[x - dx], for one row of words
+  void shiftRow(const word_type *in, word_type *out, std::ptrdiff_t dx) const {
+    auto const n = static_cast<std::ptrdiff_t>(m_stride);
+    auto const q = (dx < 0 ? -dx : dx) / static_cast<std::ptrdiff_t>(WordBits);
+    auto const r = static_cast<unsigned>((dx < 0 ? -dx : dx) % static_cast<std::ptrdiff_t>(WordBits));
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      word_type w = 0;
+      if (dx >= 0) {
+        if (i - q >= 0)
+          w |= in[i - q] << r;
+        if (r && i - q - 1 >= 0)
+          w |= in[i - q - 1] >> (WordBits - r);
+      } else {
+        if (i + q < n)
+          w |= in[i + q] >> r;
+        if (r && i + q + 1 < n)
+          w |= in[i + q + 1] << (WordBits - r);
+      }
+      out[i] = w;
+    }
+  }
+
+  /// clear the unused bits at the end of every row
+  void maskTail() {
+    auto const used = m_columns % WordBits;
+    if (used == 0)
+      return;
+    auto const mask = (word_type{1} << used) - 1;
+    for (std::size_t y = 0; y < m_rows; ++y)
+      m_words[y * m_stride + m_stride - 1] &= mask;
+  }
+
+  std::size_t m_rows{}, m_columns{}, m_stride{};
+  std::vector<word_type> m_words;
+};
+
+} // namespace AoC
+
+#endif // BITGRID_H
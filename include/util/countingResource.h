@@ -0,0 +1,71 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef COUNTINGRESOURCE_H
+#define COUNTINGRESOURCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+
+namespace AoC {
+
+/**
+ * @class CountingResource
+ * @brief std::pmr::memory_resource that forwards to an upstream resource, and
+ * keeps track of the current and the peak number of allocated bytes.
+ *
+ * It is not thread safe, just like the unsynchronized pools it is meant to
+ * sit below.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+  explicit CountingResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) : m_upstream{upstream} {}
+
+  /** @brief bytes currently allocated from the upstream resource */
+  [[nodiscard]] std::size_t current() const { return m_current; }
+
+  /** @brief highest number of bytes allocated at the same time */
+  [[nodiscard]] std::size_t peak() const { return m_peak; }
+
+  /** @brief the resource all requests are forwarded to */
+  [[nodiscard]] std::pmr::memory_resource *upstream() const { return m_upstream; }
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void *p = m_upstream->allocate(bytes, alignment);
+    m_current += bytes;
+    m_peak = std::max(m_peak, m_current);
+    return p;
+  }
+
+  void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+    m_upstream->deallocate(p, bytes, alignment);
+    m_current -= bytes;
+  }
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &o) const noexcept override { return this == &o; }
+
+  std::pmr::memory_resource *m_upstream;
+  std::size_t m_current{}, m_peak{};
+};
+
+} // namespace AoC
+
+#endif // COUNTINGRESOURCE_H
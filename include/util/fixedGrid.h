@@ -0,0 +1,258 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIXEDGRID_H
+#define FIXEDGRID_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "gridKernels.h"
+#include "numericGrid.h"
+#include "stencil.h"
+
+namespace AoC {
+
+/**
+ * @brief a numeric grid with dimensions known at compile time.
+ *
+ * The cells live in a `std::array` inside the object, so small grids stay on the stack, and every index calculation
+ * uses constant strides. Together with the fixed trip counts of stencils, this lets the compiler unroll and vectorize
+ * whole grid passes. All access is `constexpr`.
+ *
+ * The input format is the same as for numericGrid.
+ *
+ * @tparam T the storage type for each cell
+ * @tparam Rows number of rows (y)
+ * @tparam Cols number of columns (x)
+ */
+template <typename T, std::size_t Rows, std::size_t Cols> class fixedGrid {
+  static_assert(Rows > 0 && Cols > 0, "fixedGrid: dimensions must not be zero");
+
+public:
+  using value_type = T;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  constexpr fixedGrid() = default;
+
+  /**
+   * @brief create a grid with every cell set to a value
+   */
+  constexpr explicit fixedGrid(const T &value) { m_grid.fill(value); }
+
+  /**
+   * @brief copy a numericGrid of the same size
+   * @throws std::invalid_argument if the dimensions differ
+   */
+  explicit fixedGrid(const numericGrid<T> &grid) {
+    if (grid.rows() != Rows || grid.columns() != Cols)
+      throw std::invalid_argument("fixedGrid: dimensions do not match");
+    std::copy(grid.data(), grid.data() + size(), m_grid.begin());
+  }
+
+  /**
+   * @brief create a grid from a buffer holding the whole input.
+   *
+   * Empty lines and `\r` line endings are ignored.
+   *
+   * @throws std::invalid_argument if the input does not have exactly `Rows` lines of `Cols` digits
+   */
+  static fixedGrid fromString(std::string_view input) {
+    fixedGrid grid;
+    std::size_t row = 0;
+    while (!input.empty()) {
+      auto eol = input.find('\n');
+      auto line = input.substr(0, eol);
+      input.remove_prefix(eol == std::string_view::npos ? input.size() : eol + 1);
+      if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+      if (line.empty())
+        continue;
+      if (row == Rows || line.size() != Cols)
+        throw std::invalid_argument("fixedGrid: dimensions do not match");
+      kernels::decodeDigits(line.data(), grid.m_grid.data() + row++ * Cols, Cols);
+    }
+    if (row != Rows)
+      throw std::invalid_argument("fixedGrid: dimensions do not match");
+    return grid;
+  }
+
+  ///@{
+  /**
+   * @brief access a specific row
+   */
+  constexpr std::span<T, Cols> operator[](std::size_t idx) { return std::span<T, Cols>{m_grid.data() + idx * Cols, Cols}; }
+  constexpr std::span<const T, Cols> operator[](std::size_t idx) const { return std::span<const T, Cols>{m_grid.data() + idx * Cols, Cols}; }
+  ///@}
+
+  ///@{
+  /**
+   * @brief get a value by position
+   * @param idx a pair of x,y
+   */
+  constexpr T &operator[](const std::pair<std::size_t, std::size_t> &idx) { return m_grid[index(idx.first, idx.second)]; }
+  constexpr const T &operator[](const std::pair<std::size_t, std::size_t> &idx) const { return m_grid[index(idx.first, idx.second)]; }
+  ///@}
+
+  /** @brief the buffer index of a position */
+  static constexpr std::size_t index(std::size_t x, std::size_t y) { return y * Cols + x; }
+
+  /** @brief true if the position is inside the grid */
+  static constexpr bool contains(std::ptrdiff_t x, std::ptrdiff_t y) {
+    return x >= 0 && y >= 0 && x < static_cast<std::ptrdiff_t>(Cols) && y < static_cast<std::ptrdiff_t>(Rows);
+  }
+
+  /**
+   * @brief translate a stencil into buffer offsets
+   *
+   * As the stride is a constant, this can be evaluated at compile time, e.g. `constexpr auto o = G::offsets(stencil8);`
+   */
+  template <std::size_t N> static constexpr std::array<std::ptrdiff_t, N> offsets(const Stencil<N> &stencil) {
+    std::array<std::ptrdiff_t, N> out{};
+    for (std::size_t i = 0; i < N; ++i)
+      out[i] = stencil[i].second * static_cast<std::ptrdiff_t>(Cols) + stencil[i].first;
+    return out;
+  }
+
+  /**
+   * @brief invoke `f(T &neighbour)` for every neighbour of a cell, that is inside the grid
+   */
+  template <std::size_t N, typename F> constexpr void forEachNeighbour(const std::pair<std::size_t, std::size_t> &pos, const Stencil<N> &stencil, F &&f) {
+    for (auto [dx, dy] : stencil) {
+      auto const x = static_cast<std::ptrdiff_t>(pos.first) + dx, y = static_cast<std::ptrdiff_t>(pos.second) + dy;
+      if (contains(x, y))
+        f(m_grid[index(static_cast<std::size_t>(x), static_cast<std::size_t>(y))]);
+    }
+  }
+
+  /**
+   * @brief apply a stencil to the whole grid.
+   *
+   * `f(const T &cell, const std::array<T, N> &neighbours)` is invoked for every cell, neighbours outside of the grid
+   * read as `border`. The results form the returned grid.
+   *
+   * @param stencil the neighbours to gather
+   * @param f the cell function
+   * @param border the value of all cells outside of the grid
+   */
+  template <std::size_t N, typename F, typename R = std::invoke_result_t<F, const T &, const std::array<T, N> &>>
+  constexpr fixedGrid<R, Rows, Cols> apply(const Stencil<N> &stencil, F &&f, T border = {}) const {
+    fixedGrid<R, Rows, Cols> out;
+    for (std::size_t y = 0; y < Rows; ++y) {
+      for (std::size_t x = 0; x < Cols; ++x) {
+        std::array<T, N> n;
+        for (std::size_t i = 0; i < N; ++i) {
+          auto const nx = static_cast<std::ptrdiff_t>(x) + stencil[i].first, ny = static_cast<std::ptrdiff_t>(y) + stencil[i].second;
+          n[i] = contains(nx, ny) ? m_grid[index(static_cast<std::size_t>(nx), static_cast<std::size_t>(ny))] : border;
+        }
+        out[std::pair{x, y}] = f(m_grid[index(x, y)], n);
+      }
+    }
+    return out;
+  }
+
+  /** @brief set every cell to a value */
+  constexpr void fill(const T &value) { m_grid.fill(value); }
+
+  ///@{
+  /**
+   * @brief count the cells matching a value or a predicate
+   */
+  [[nodiscard]] constexpr std::size_t count(const T &v) const { return static_cast<std::size_t>(std::count(m_grid.begin(), m_grid.end(), v)); }
+  template <typename Pred> [[nodiscard]] constexpr std::size_t countIf(Pred &&pred) const {
+    return static_cast<std::size_t>(std::count_if(m_grid.begin(), m_grid.end(), std::forward<Pred>(pred)));
+  }
+  ///@}
+
+  /** @brief copy into a dynamically sized numericGrid */
+  [[nodiscard]] numericGrid<T> toGrid() const {
+    numericGrid<T> out{Rows, Cols};
+    std::copy(m_grid.begin(), m_grid.end(), out.data());
+    return out;
+  }
+
+  ///@{
+  /**
+   * @brief direct access to the underlying row-major buffer
+   */
+  constexpr T *data() { return m_grid.data(); }
+  constexpr const T *data() const { return m_grid.data(); }
+  ///@}
+
+  ///@{
+  /**
+   * @brief iterate over all cells in row-major order
+   */
+  constexpr iterator begin() { return m_grid.data(); }
+  constexpr const_iterator begin() const { return m_grid.data(); }
+  constexpr iterator end() { return m_grid.data() + size(); }
+  constexpr const_iterator end() const { return m_grid.data() + size(); }
+  ///@}
+
+  /** @brief get the number of elements */
+  static constexpr std::size_t size() { return Rows * Cols; }
+
+  /** @brief get the number of rows (y) */
+  static constexpr std::size_t rows() { return Rows; }
+
+  /** @brief get the number of columns (x) */
+  static constexpr std::size_t columns() { return Cols; }
+
+  constexpr bool operator==(const fixedGrid &) const = default;
+
+  /**
+   * @brief operator to load a whole grid from a std::istream
+   *
+   * Reads exactly `Rows` non empty lines. A line with a different length than `Cols`, or too few lines, sets the
+   * `failbit` of the stream.
+   */
+  friend std::istream &operator>>(std::istream &is, fixedGrid &grid) {
+    std::string line;
+    std::size_t row = 0;
+    while (row < Rows && std::getline(is, line)) {
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+      if (line.empty())
+        continue;
+      if (line.size() != Cols)
+        break;
+      kernels::decodeDigits(line.data(), grid.m_grid.data() + row++ * Cols, Cols);
+    }
+    if (row != Rows)
+      is.setstate(std::ios::failbit);
+    return is;
+  }
+
+private:
+  std::array<T, Rows * Cols> m_grid{};
+};
+
+} // namespace AoC
+
+#endif // FIXEDGRID_H
@@ -0,0 +1,397 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GRIDKERNELS_H
+#define GRIDKERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define AOC_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @namespace AoC::kernels
+ *
+ * @brief bulk operations on plain memory blocks, as used by numericGrid.
+ *
+ * Byte sized cells are processed with SSE2 or AVX2, selected once at runtime. All other cell types use a scalar loop.
+ */
+namespace AoC::kernels {
+
+/** @brief instruction set used by a kernel table */
+enum class Isa { Scalar, SSE2, AVX2 };
+
+/**
+ * @brief function table for the byte kernels of one instruction set.
+ *
+ * All functions work on `n` consecutive bytes. The add/sub functions wrap around, the saturating versions stop at 0 and 255.
+ */
+struct KernelTable {
+  Isa isa;
+  void (*decodeDigits)(const char *in, std::uint8_t *out, std::size_t n);
+  void (*add)(std::uint8_t *data, std::size_t n, std::uint8_t v);
+  void (*sub)(std::uint8_t *data, std::size_t n, std::uint8_t v);
+  void (*addSaturate)(std::uint8_t *data, std::size_t n, std::uint8_t v);
+  void (*subSaturate)(std::uint8_t *data, std::size_t n, std::uint8_t v);
+  void (*clamp)(std::uint8_t *data, std::size_t n, std::uint8_t lo, std::uint8_t hi);
+  std::size_t (*countEqual)(const std::uint8_t *data, std::size_t n, std::uint8_t v);
+  std::size_t (*countAtLeast)(const std::uint8_t *data, std::size_t n, std::uint8_t v);
+  std::size_t (*findAtLeast)(const std::uint8_t *data, std::size_t n, std::uint8_t v);
+};
+
+namespace scalar {
+inline void decodeDigits(const char *in, std::uint8_t *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = static_cast<std::uint8_t>(in[i] - '0');
+}
+inline void add(std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  for (std::size_t i = 0; i < n; ++i)
+    data[i] = static_cast<std::uint8_t>(data[i] + v);
+}
+inline void sub(std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  for (std::size_t i = 0; i < n; ++i)
+    data[i] = static_cast<std::uint8_t>(data[i] - v);
+}
+inline void addSaturate(std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  for (std::size_t i = 0; i < n; ++i)
+    data[i] = data[i] > 255 - v ? 255 : static_cast<std::uint8_t>(data[i] + v);
+}
+inline void subSaturate(std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  for (std::size_t i = 0; i < n; ++i)
+    data[i] = data[i] < v ? 0 : static_cast<std::uint8_t>(data[i] - v);
+}
+inline void clamp(std::uint8_t *data, std::size_t n, std::uint8_t lo, std::uint8_t hi) {
+  for (std::size_t i = 0; i < n; ++i)
+    data[i] = std::min(std::max(data[i], lo), hi);
+}
+inline std::size_t countEqual(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i)
+    count += data[i] == v;
+  return count;
+}
+inline std::size_t countAtLeast(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i)
+    count += data[i] >= v;
+  return count;
+}
+inline std::size_t findAtLeast(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  for (std::size_t i = 0; i < n; ++i)
+    if (data[i] >= v)
+      return i;
+  return n;
+}
+
+inline constexpr KernelTable table{Isa::Scalar, decodeDigits, add, sub, addSaturate, subSaturate, clamp, countEqual, countAtLeast, findAtLeast};
+} // namespace scalar
+
+#ifdef AOC_KERNELS_X86
+
+// The vector kernels share their structure between SSE2 and AVX2. Each one processes full vectors, and leaves the tail to the
+// scalar version.
+#define AOC_KERNEL_MAP(NAME, ATTR, VEC, LOAD, STORE, WIDTH, SCALAR_CALL, ...)                                                                                  \
+  ATTR inline void NAME(std::uint8_t *data, std::size_t n, std::uint8_t v) {                                                                                    \
+    std::size_t i = 0;                                                                                                                                         \
+    for (; i + WIDTH <= n; i += WIDTH) {                                                                                                                        \
+      VEC x = LOAD(reinterpret_cast<const VEC *>(data + i));                                                                                                    \
+      STORE(reinterpret_cast<VEC *>(data + i), __VA_ARGS__);                                                                                                    \
+    }                                                                                                                                                          \
+    scalar::SCALAR_CALL(data + i, n - i, v);                                                                                                                    \
+  }
+
+namespace sse2 {
+#define AOC_SSE2 __attribute__((target("sse2")))
+
+AOC_SSE2 inline void decodeDigits(const char *in, std::uint8_t *out, std::size_t n) {
+  const __m128i zero = _mm_set1_epi8('0');
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), zero));
+  scalar::decodeDigits(in + i, out + i, n - i);
+}
+
+AOC_KERNEL_MAP(add, AOC_SSE2, __m128i, _mm_loadu_si128, _mm_storeu_si128, 16, add, _mm_add_epi8(x, _mm_set1_epi8(static_cast<char>(v))))
+AOC_KERNEL_MAP(sub, AOC_SSE2, __m128i, _mm_loadu_si128, _mm_storeu_si128, 16, sub, _mm_sub_epi8(x, _mm_set1_epi8(static_cast<char>(v))))
+AOC_KERNEL_MAP(addSaturate, AOC_SSE2, __m128i, _mm_loadu_si128, _mm_storeu_si128, 16, addSaturate, _mm_adds_epu8(x, _mm_set1_epi8(static_cast<char>(v))))
+AOC_KERNEL_MAP(subSaturate, AOC_SSE2, __m128i, _mm_loadu_si128, _mm_storeu_si128, 16, subSaturate, _mm_subs_epu8(x, _mm_set1_epi8(static_cast<char>(v))))
+
+AOC_SSE2 inline void clamp(std::uint8_t *data, std::size_t n, std::uint8_t lo, std::uint8_t hi) {
+  const __m128i vlo = _mm_set1_epi8(static_cast<char>(lo)), vhi = _mm_set1_epi8(static_cast<char>(hi));
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), _mm_min_epu8(_mm_max_epu8(x, vlo), vhi));
+  }
+  scalar::clamp(data + i, n - i, lo, hi);
+}
+
+AOC_SSE2 inline std::size_t countEqual(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  const __m128i vv = _mm_set1_epi8(static_cast<char>(v));
+  std::size_t count = 0, i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, vv))));
+  }
+  return count + scalar::countEqual(data + i, n - i, v);
+}
+
+// x >= v is the same as max(x, v) == x for unsigned bytes
+AOC_SSE2 inline std::size_t countAtLeast(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  const __m128i vv = _mm_set1_epi8(static_cast<char>(v));
+  std::size_t count = 0, i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(x, vv), x))));
+  }
+  return count + scalar::countAtLeast(data + i, n - i, v);
+}
+
+AOC_SSE2 inline std::size_t findAtLeast(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  const __m128i vv = _mm_set1_epi8(static_cast<char>(v));
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(x, vv), x)));
+    if (mask)
+      return i + static_cast<std::size_t>(__builtin_ctz(mask));
+  }
+  return i + scalar::findAtLeast(data + i, n - i, v);
+}
+
+#undef AOC_SSE2
+
+inline constexpr KernelTable table{Isa::SSE2, decodeDigits, add, sub, addSaturate, subSaturate, clamp, countEqual, countAtLeast, findAtLeast};
+} // namespace sse2
+
+namespace avx2 {
+#define AOC_AVX2 __attribute__((target("avx2")))
+
+AOC_AVX2 inline void decodeDigits(const char *in, std::uint8_t *out, std::size_t n) {
+  const __m256i zero = _mm256_set1_epi8('0');
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)), zero));
+  scalar::decodeDigits(in + i, out + i, n - i);
+}
+
+AOC_KERNEL_MAP(add, AOC_AVX2, __m256i, _mm256_loadu_si256, _mm256_storeu_si256, 32, add, _mm256_add_epi8(x, _mm256_set1_epi8(static_cast<char>(v))))
+AOC_KERNEL_MAP(sub, AOC_AVX2, __m256i, _mm256_loadu_si256, _mm256_storeu_si256, 32, sub, _mm256_sub_epi8(x, _mm256_set1_epi8(static_cast<char>(v))))
+AOC_KERNEL_MAP(addSaturate, AOC_AVX2, __m256i, _mm256_loadu_si256, _mm256_storeu_si256, 32, addSaturate,
+               _mm256_adds_epu8(x, _mm256_set1_epi8(static_cast<char>(v))))
+AOC_KERNEL_MAP(subSaturate, AOC_AVX2, __m256i, _mm256_loadu_si256, _mm256_storeu_si256, 32, subSaturate,
+               _mm256_subs_epu8(x, _mm256_set1_epi8(static_cast<char>(v))))
+
+AOC_AVX2 inline void clamp(std::uint8_t *data, std::size_t n, std::uint8_t lo, std::uint8_t hi) {
+  const __m256i vlo = _mm256_set1_epi8(static_cast<char>(lo)), vhi = _mm256_set1_epi8(static_cast<char>(hi));
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), _mm256_min_epu8(_mm256_max_epu8(x, vlo), vhi));
+  }
+  scalar::clamp(data + i, n - i, lo, hi);
+}
+
+AOC_AVX2 inline std::size_t countEqual(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  const __m256i vv = _mm256_set1_epi8(static_cast<char>(v));
+  std::size_t count = 0, i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, vv))));
+  }
+  return count + scalar::countEqual(data + i, n - i, v);
+}
+
+AOC_AVX2 inline std::size_t countAtLeast(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  const __m256i vv = _mm256_set1_epi8(static_cast<char>(v));
+  std::size_t count = 0, i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(x, vv), x))));
+  }
+  return count + scalar::countAtLeast(data + i, n - i, v);
+}
+
+AOC_AVX2 inline std::size_t findAtLeast(const std::uint8_t *data, std::size_t n, std::uint8_t v) {
+  const __m256i vv = _mm256_set1_epi8(static_cast<char>(v));
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(x, vv), x)));
+    if (mask)
+      return i + static_cast<std::size_t>(__builtin_ctz(mask));
+  }
+  return i + scalar::findAtLeast(data + i, n - i, v);
+}
+
+#undef AOC_AVX2
+
+inline constexpr KernelTable table{Isa::AVX2, decodeDigits, add, sub, addSaturate, subSaturate, clamp, countEqual, countAtLeast, findAtLeast};
+} // namespace avx2
+
+#undef AOC_KERNEL_MAP
+
+#endif // AOC_KERNELS_X86
+
+/**
+ * @brief the kernel table for the best instruction set of the running CPU.
+ *
+ * The check is done once, on first use.
+ */
+inline const KernelTable &table() {
+#ifdef AOC_KERNELS_X86
+  static const KernelTable &best = [] () -> const KernelTable & {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      return avx2::table;
+    if (__builtin_cpu_supports("sse2"))
+      return sse2::table;
+    return scalar::table;
+  }();
+  return best;
+#else
+  return scalar::table;
+#endif
+}
+
+/** @brief true, if T is handled by the byte kernels. `bool` is not, it may only hold 0 and 1. */
+template <typename T>
+inline constexpr bool isByteCell = std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) == 1 && !std::is_same_v<T, bool>;
+
+///@{
+/**
+ * @brief typed entry points.
+ *
+ * Byte sized unsigned types are dispatched to the vector kernels, everything else uses a plain loop.
+ */
+template <typename T> void decodeDigits(const char *in, T *out, std::size_t n) {
+  if constexpr (isByteCell<T>)
+    table().decodeDigits(in, reinterpret_cast<std::uint8_t *>(out), n);
+  else
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = static_cast<T>(in[i] - '0');
+}
+
+template <typename T> void add(T *data, std::size_t n, T v) {
+  if constexpr (isByteCell<T>)
+    table().add(reinterpret_cast<std::uint8_t *>(data), n, v);
+  else
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] += v;
+}
+
+template <typename T> void sub(T *data, std::size_t n, T v) {
+  if constexpr (isByteCell<T>)
+    table().sub(reinterpret_cast<std::uint8_t *>(data), n, v);
+  else
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] -= v;
+}
+
+// true if v is negative, without a comparison, that is always false for unsigned types
+template <typename T> constexpr bool isNegative(T v) {
+  if constexpr (std::is_signed_v<T>)
+    return v < T{};
+  else
+    return false;
+}
+
+template <typename T> void addSaturate(T *data, std::size_t n, T v) {
+  using limits = std::numeric_limits<T>;
+  if constexpr (isByteCell<T>)
+    table().addSaturate(reinterpret_cast<std::uint8_t *>(data), n, v);
+  else if (isNegative(v))
+    // the bound is computed towards zero, so it does not overflow for signed types
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] = data[i] < limits::lowest() - v ? limits::lowest() : static_cast<T>(data[i] + v);
+  else
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] = data[i] > limits::max() - v ? limits::max() : static_cast<T>(data[i] + v);
+}
+
+template <typename T> void subSaturate(T *data, std::size_t n, T v) {
+  using limits = std::numeric_limits<T>;
+  if constexpr (isByteCell<T>)
+    table().subSaturate(reinterpret_cast<std::uint8_t *>(data), n, v);
+  else if (isNegative(v))
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] = data[i] > limits::max() + v ? limits::max() : static_cast<T>(data[i] - v);
+  else
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] = data[i] < limits::lowest() + v ? limits::lowest() : static_cast<T>(data[i] - v);
+}
+
+template <typename T> void clamp(T *data, std::size_t n, T lo, T hi) {
+  if constexpr (isByteCell<T>)
+    table().clamp(reinterpret_cast<std::uint8_t *>(data), n, lo, hi);
+  else
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] = std::clamp(data[i], lo, hi);
+}
+
+template <typename T> std::size_t countEqual(const T *data, std::size_t n, T v) {
+  if constexpr (isByteCell<T>)
+    return table().countEqual(reinterpret_cast<const std::uint8_t *>(data), n, v);
+  else
+    return static_cast<std::size_t>(std::count(data, data + n, v));
+}
+
+template <typename T> std::size_t countAtLeast(const T *data, std::size_t n, T v) {
+  if constexpr (isByteCell<T>)
+    return table().countAtLeast(reinterpret_cast<const std::uint8_t *>(data), n, v);
+  else
+    return static_cast<std::size_t>(std::count_if(data, data + n, [v](const T &x) { return x >= v; }));
+}
+
+template <typename T> std::size_t findAtLeast(const T *data, std::size_t n, T v) {
+  if constexpr (isByteCell<T>)
+    return table().findAtLeast(reinterpret_cast<const std::uint8_t *>(data), n, v);
+  else
+    return static_cast<std::size_t>(std::find_if(data, data + n, [v](const T &x) { return x >= v; }) - data);
+}
+///@}
+
+/**
+ * @brief transpose a row-major block of `rows` x `columns` cells into `out`, which has `columns` rows of `rows` cells.
+ *
+ * The copy is done in square tiles of one cache line per tile row, so both the reads and the writes stay inside a few
+ * cache lines, instead of striding through the whole output for every input row.
+ */
+template <typename T> void transpose(const T *in, T *out, std::size_t rows, std::size_t columns) {
+  constexpr std::size_t Tile = std::max<std::size_t>(8, 64 / sizeof(T));
+  for (std::size_t y0 = 0; y0 < rows; y0 += Tile) {
+    auto const y1 = std::min(rows, y0 + Tile);
+    for (std::size_t x0 = 0; x0 < columns; x0 += Tile) {
+      auto const x1 = std::min(columns, x0 + Tile);
+      for (std::size_t y = y0; y < y1; ++y)
+        for (std::size_t x = x0; x < x1; ++x)
+          out[x * rows + y] = in[y * columns + x];
+    }
+  }
+}
+
+} // namespace AoC::kernels
+
+#endif // GRIDKERNELS_H
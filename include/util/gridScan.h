@@ -0,0 +1,100 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GRIDSCAN_H
+#define GRIDSCAN_H
+
+#include <cstddef>
+#include <utility>
+
+#include "numericGrid.h"
+
+namespace AoC {
+
+/**
+ * @brief the results of scanDirections(), one grid per edge the scan starts from
+ */
+template <typename R> struct DirectionScan {
+  numericGrid<R> fromLeft, fromRight, fromTop, fromBottom;
+};
+
+/**
+ * @brief prefix scans of a grid from all four edges, e.g. a prefix max for line of sight, or prefix sums.
+ *
+ * `fromLeft[{x, y}]` holds `op(...op(op(init, cell(0, y)), cell(1, y))..., cell(x - 1, y))`, the fold over all cells
+ * between the left edge and the cell. The other directions work the same way. With `inclusive`, the cell itself is
+ * part of the fold as well.
+ *
+ * All passes read and write whole rows: the horizontal scans walk each row forward and backward, and the vertical
+ * scans combine a row with the result of the row before it, cell by cell. No pass walks down a column, so the
+ * vertical scans run at the speed of a linear copy, and can be vectorized.
+ *
+ * @param grid the grid to scan
+ * @param init the value before the first cell, e.g. -1 for a prefix max over digits
+ * @param op `R op(const R &acc, const T &cell)`
+ * @param inclusive include the cell itself
+ */
+template <typename T, typename R, typename Op>
+DirectionScan<R> scanDirections(const numericGrid<T> &grid, R init, Op &&op, bool inclusive = false) {
+  auto const rows = grid.rows(), columns = grid.columns();
+  DirectionScan<R> out{numericGrid<R>{rows, columns}, numericGrid<R>{rows, columns}, numericGrid<R>{rows, columns},
+                       numericGrid<R>{rows, columns}};
+
+  for (std::size_t y = 0; y < rows; ++y) {
+    auto const in = grid[y];
+    auto left = out.fromLeft[y], right = out.fromRight[y];
+    R acc = init;
+    for (std::size_t x = 0; x < columns; ++x) {
+      R next = op(std::as_const(acc), in[x]);
+      left[x] = inclusive ? next : acc;
+      acc = std::move(next);
+    }
+    acc = init;
+    for (std::size_t x = columns; x-- > 0;) {
+      R next = op(std::as_const(acc), in[x]);
+      right[x] = inclusive ? next : acc;
+      acc = std::move(next);
+    }
+  }
+
+  // row y of a vertical scan, prev is the row the scan comes from
+  auto vertical = [&](numericGrid<R> &dst, std::size_t y, std::size_t prev, bool edge) {
+    auto row = dst[y];
+    if (edge) {
+      auto const in = grid[y];
+      for (std::size_t x = 0; x < columns; ++x)
+        row[x] = inclusive ? R(op(init, in[x])) : init;
+      return;
+    }
+    auto const acc = std::as_const(dst)[prev];
+    auto const in = grid[inclusive ? y : prev];
+    for (std::size_t x = 0; x < columns; ++x)
+      row[x] = op(acc[x], in[x]);
+  };
+  for (std::size_t y = 0; y < rows; ++y)
+    vertical(out.fromTop, y, y - 1, y == 0);
+  for (std::size_t y = rows; y-- > 0;)
+    vertical(out.fromBottom, y, y + 1, y + 1 == rows);
+
+  return out;
+}
+
+} // namespace AoC
+
+#endif // GRIDSCAN_H
@@ -0,0 +1,243 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef INPUTSOURCE_H
+#define INPUTSOURCE_H
+
+#include <algorithm>
+#include <cerrno>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "mappedFile.h"
+
+// same switch as in mappedFile.h, undefined again at the end of this header
+#if !defined(AOC_NO_MMAP) && __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define AOC_INPUTSOURCE_POSIX
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <iostream>
+#include <iterator>
+#endif
+
+namespace AoC {
+
+/**
+ * @class ViewStreamBuf
+ * @brief read only stream buffer over memory that is already there, e.g. a MappedFile.
+ *
+ * The whole input is the get area, so reading never copies and never calls underflow().
+ */
+class ViewStreamBuf : public std::streambuf {
+public:
+  explicit ViewStreamBuf(std::string_view data) {
+    // the stream never writes to the get area
+    auto *begin = const_cast<char *>(data.data());
+    setg(begin, begin, begin + data.size());
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+    if (!(which & std::ios_base::in))
+      return pos_type(off_type(-1));
+    off_type base = dir == std::ios_base::beg ? 0 : dir == std::ios_base::cur ? gptr() - eback() : egptr() - eback();
+    return seekpos(pos_type(base + off), which);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    auto const off = off_type(pos);
+    if (!(which & std::ios_base::in) || off < 0 || off > egptr() - eback())
+      return pos_type(off_type(-1));
+    setg(eback(), eback() + off, egptr());
+    return pos;
+  }
+
+  std::streamsize showmanyc() override { return egptr() - gptr(); }
+};
+
+#ifdef AOC_INPUTSOURCE_POSIX
+/**
+ * @class FdStreamBuf
+ * @brief read only stream buffer over a file descriptor, reading in large blocks.
+ *
+ * Used for pipes and terminals, that can not be mapped.
+ */
+class FdStreamBuf : public std::streambuf {
+public:
+  static constexpr std::size_t BlockSize = std::size_t{1} << 20;
+
+  explicit FdStreamBuf(int fd) : m_fd{fd}, m_buffer{std::make_unique_for_overwrite<char[]>(BlockSize)} {}
+
+protected:
+  int_type underflow() override {
+    if (gptr() < egptr())
+      return traits_type::to_int_type(*gptr());
+    ssize_t n;
+    do {
+      n = ::read(m_fd, m_buffer.get(), BlockSize);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0)
+      return traits_type::eof();
+    setg(m_buffer.get(), m_buffer.get(), m_buffer.get() + n);
+    return traits_type::to_int_type(*gptr());
+  }
+
+private:
+  int m_fd;
+  std::unique_ptr<char[]> m_buffer;
+};
+#endif
+
+/**
+ * @class InputSource
+ * @brief the puzzle input, from a file or from stdin
+ *
+ * Regular files (including stdin redirected from a file, from its current position) are memory mapped. Everything
+ * else, like pipes, is read in large blocks. Without POSIX, files are read as a whole through MappedFile, and stdin
+ * through std::cin. The input is either consumed through stream() or as a whole through view(), but not both.
+ *
+ * @throws std::system_error if the input can not be opened
+ */
+class InputSource {
+public:
+  /**
+   * @brief open an input
+   * @param name the file name, or `-` for stdin
+   */
+  explicit InputSource(const std::string &name) : m_name{name} {
+#ifdef AOC_INPUTSOURCE_POSIX
+    if (name == "-") {
+      m_fd = STDIN_FILENO;
+    } else {
+      m_fd = ::open(name.c_str(), O_RDONLY);
+      if (m_fd < 0)
+        throw std::system_error(errno, std::generic_category(), name);
+      m_owned = true;
+    }
+
+    struct stat st {};
+    if (::fstat(m_fd, &st) < 0) {
+      auto err = errno;
+      close();
+      throw std::system_error(err, std::generic_category(), name);
+    }
+    if (S_ISREG(st.st_mode)) {
+      try {
+        m_map.emplace(m_fd, name);
+      } catch (...) {
+        close();
+        throw;
+      }
+      close();
+    }
+#else
+    if (name != "-")
+      m_map.emplace(name);
+#endif
+  }
+
+  InputSource(const InputSource &) = delete;
+  InputSource &operator=(const InputSource &) = delete;
+
+  ~InputSource() { close(); }
+
+  /** @brief true if the input is memory mapped */
+  [[nodiscard]] bool mapped() const { return m_map.has_value(); }
+
+  /**
+   * @brief the whole input
+   *
+   * Inputs that are not mapped are read completely on the first call.
+   */
+  std::string_view view() {
+    if (m_map)
+      return m_map->view();
+    if (!m_data) {
+#ifdef AOC_INPUTSOURCE_POSIX
+      m_data.emplace();
+      std::size_t size = 0;
+      for (;;) {
+        if (size == m_data->size())
+          m_data->resize(std::max(size + FdStreamBuf::BlockSize, 2 * size));
+        ssize_t n = ::read(m_fd, m_data->data() + size, m_data->size() - size);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n < 0)
+          throw std::system_error(errno, std::generic_category(), m_name);
+        if (n == 0)
+          break;
+        size += static_cast<std::size_t>(n);
+      }
+      m_data->resize(size);
+#else
+      m_data.emplace(std::istreambuf_iterator<char>{std::cin}, std::istreambuf_iterator<char>{});
+#endif
+    }
+    return *m_data;
+  }
+
+  /** @brief the input as stream */
+  std::istream &stream() {
+    if (!m_buf) {
+      if (m_map)
+        m_buf = std::make_unique<ViewStreamBuf>(m_map->view());
+#ifdef AOC_INPUTSOURCE_POSIX
+      else
+        m_buf = std::make_unique<FdStreamBuf>(m_fd);
+      m_stream.rdbuf(m_buf.get());
+#else
+      m_stream.rdbuf(m_buf ? m_buf.get() : std::cin.rdbuf());
+#endif
+    }
+    return m_stream;
+  }
+
+private:
+  void close() {
+#ifdef AOC_INPUTSOURCE_POSIX
+    if (m_owned)
+      ::close(m_fd);
+    m_owned = false;
+    m_fd = -1;
+#endif
+  }
+
+  std::string m_name;
+#ifdef AOC_INPUTSOURCE_POSIX
+  int m_fd{-1};
+  bool m_owned{false};
+#endif
+  std::optional<MappedFile> m_map;
+  std::optional<std::string> m_data;
+  std::unique_ptr<std::streambuf> m_buf;
+  std::istream m_stream{nullptr};
+};
+
+} // namespace AoC
+
+#undef AOC_INPUTSOURCE_POSIX
+
+#endif // INPUTSOURCE_H
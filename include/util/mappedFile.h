@@ -0,0 +1,156 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+// memory mapping needs POSIX. Elsewhere, or with AOC_NO_MMAP defined, the file is read into an owned buffer.
+#if !defined(AOC_NO_MMAP) && __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace AoC {
+
+/**
+ * @class MappedFile
+ * @brief read only memory mapping of a whole input file
+ *
+ * The file is mapped once and can be accessed as a std::string_view, without copying it into a stream buffer first.
+ * Empty files result in an empty view. Without POSIX, the file is read into a buffer instead.
+ *
+ * @throws std::system_error if the file can not be opened or mapped
+ */
+class MappedFile {
+public:
+#if !defined(AOC_NO_MMAP) && __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+  explicit MappedFile(const std::string &filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::system_error(errno, std::generic_category(), filename);
+
+    try {
+      map(fd, filename);
+    } catch (...) {
+      ::close(fd);
+      throw;
+    }
+    ::close(fd);
+  }
+
+  /**
+   * @brief map an already opened file, from its current position to the end
+   *
+   * Used for stdin redirected from a file, where something might have been read already.
+   *
+   * @param fd the file descriptor, it stays open and is still owned by the caller
+   * @param name the name used in error messages
+   */
+  MappedFile(int fd, const std::string &name) { map(fd, name); }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile(MappedFile &&o) noexcept
+      : m_data{std::exchange(o.m_data, nullptr)}, m_size{std::exchange(o.m_size, 0)}, m_skip{std::exchange(o.m_skip, 0)} {}
+
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile &operator=(MappedFile &&o) noexcept {
+    std::swap(m_data, o.m_data);
+    std::swap(m_size, o.m_size);
+    std::swap(m_skip, o.m_skip);
+    return *this;
+  }
+
+  ~MappedFile() {
+    if (m_data)
+      ::munmap(const_cast<char *>(m_data - m_skip), m_size + m_skip);
+  }
+
+  /** @brief the whole file content */
+  [[nodiscard]] std::string_view view() const { return {m_data, m_size}; }
+
+  [[nodiscard]] const char *data() const { return m_data; }
+  [[nodiscard]] std::size_t size() const { return m_size; }
+
+private:
+  void map(int fd, const std::string &name) {
+    struct stat st {};
+    if (::fstat(fd, &st) < 0)
+      throw std::system_error(errno, std::generic_category(), name);
+
+    off_t const offset = ::lseek(fd, 0, SEEK_CUR);
+    if (offset < 0)
+      throw std::system_error(errno, std::generic_category(), name);
+    if (offset >= st.st_size)
+      return;
+
+    // mappings start at a page boundary, skip the part before the offset
+    auto const page = static_cast<off_t>(::sysconf(_SC_PAGESIZE));
+    off_t const start = offset - offset % page;
+    m_skip = static_cast<std::size_t>(offset - start);
+    m_size = static_cast<std::size_t>(st.st_size - offset);
+
+    void *ptr = ::mmap(nullptr, m_size + m_skip, PROT_READ, MAP_PRIVATE, fd, start);
+    if (ptr == MAP_FAILED) {
+      m_size = m_skip = 0;
+      throw std::system_error(errno, std::generic_category(), name);
+    }
+    // we read the input front to back, tell the kernel about it
+    ::madvise(ptr, m_size + m_skip, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(ptr) + m_skip;
+  }
+
+  const char *m_data{};
+  std::size_t m_size{};
+  // distance between m_data and the start of the mapping
+  std::size_t m_skip{};
+#else
+  explicit MappedFile(const std::string &filename) {
+    std::ifstream in{filename, std::ios_base::binary};
+    if (!in)
+      throw std::system_error(errno, std::generic_category(), filename);
+    m_buffer.assign(std::istreambuf_iterator<char>{in}, {});
+    if (in.bad())
+      throw std::system_error(errno, std::generic_category(), filename);
+  }
+
+  /** @brief the whole file content */
+  [[nodiscard]] std::string_view view() const { return m_buffer; }
+
+  [[nodiscard]] const char *data() const { return m_buffer.data(); }
+  [[nodiscard]] std::size_t size() const { return m_buffer.size(); }
+
+private:
+  std::string m_buffer;
+#endif
+};
+
+} // namespace AoC
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,312 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NIBBLEGRID_H
+#define NIBBLEGRID_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "bitGrid.h"
+#include "numericGrid.h"
+
+namespace AoC {
+
+/**
+ * @brief a numeric grid with 4 bit cells, for inputs of single digits.
+ *
+ * The cells are stored row-major, 16 per 64 bit word, so the grid takes an eighth of the memory of a
+ * `numericGrid<uint64_t>`, and half of a byte grid. Whole grid operations work on full words, treating every nibble as
+ * an independent lane (SWAR), so they handle 16 cells per instruction. The unused nibbles at the end of the last word
+ * are always zero.
+ *
+ * Single cells are accessed through a proxy reference. Values are always taken modulo 16.
+ */
+class nibbleGrid {
+public:
+  using word_type = std::uint64_t;
+  static constexpr std::size_t Lanes = 16;
+
+  /**
+   * @brief proxy for a single cell of the grid
+   */
+  class reference {
+  public:
+    reference(word_type *word, unsigned shift) : m_word{word}, m_shift{shift} {}
+
+    operator std::uint8_t() const { return static_cast<std::uint8_t>((*m_word >> m_shift) & 0xf); }
+
+    reference &operator=(std::uint8_t v) {
+      *m_word = (*m_word & ~(word_type{0xf} << m_shift)) | (static_cast<word_type>(v & 0xf) << m_shift);
+      return *this;
+    }
+    reference &operator=(const reference &other) { return *this = static_cast<std::uint8_t>(other); }
+
+  private:
+    word_type *m_word;
+    unsigned m_shift;
+  };
+
+  nibbleGrid() = default;
+
+  /**
+   * @brief create a grid with a fixed size
+   * @param rows number of rows (y)
+   * @param columns number of columns (x)
+   * @param value initial value of each cell
+   */
+  nibbleGrid(std::size_t rows, std::size_t columns, std::uint8_t value = 0)
+      : m_rows{rows}, m_columns{columns}, m_words((rows * columns + Lanes - 1) / Lanes) {
+    fill(value);
+  }
+
+  /**
+   * @brief copy a numericGrid, keeping the lower 4 bits of each cell
+   */
+  template <typename T> explicit nibbleGrid(const numericGrid<T> &grid) : nibbleGrid(grid.rows(), grid.columns()) {
+    for (std::size_t i = 0; i < size(); ++i)
+      m_words[i / Lanes] |= (static_cast<word_type>(grid.data()[i]) & 0xf) << shift(i);
+  }
+
+  /**
+   * @brief create a grid from a buffer holding the whole input.
+   *
+   * Empty lines and `\r` line endings are ignored.
+   *
+   * @throws std::invalid_argument if the rows differ in length
+   */
+  static nibbleGrid fromString(std::string_view input) { return nibbleGrid{numericGrid<std::uint8_t>::fromString(input)}; }
+
+  ///@{
+  /**
+   * @brief get a cell by position
+   * @param idx a pair of x,y
+   */
+  reference operator[](const std::pair<std::size_t, std::size_t> &idx) {
+    auto const i = idx.second * m_columns + idx.first;
+    return {m_words.data() + i / Lanes, shift(i)};
+  }
+  std::uint8_t operator[](const std::pair<std::size_t, std::size_t> &idx) const {
+    auto const i = idx.second * m_columns + idx.first;
+    return static_cast<std::uint8_t>((m_words[i / Lanes] >> shift(i)) & 0xf);
+  }
+  ///@}
+
+  ///@{
+  /**
+   * @brief all words of the grid
+   */
+  std::span<word_type> words() { return m_words; }
+  std::span<const word_type> words() const { return m_words; }
+  ///@}
+
+  /** @brief set all cells to a value */
+  void fill(std::uint8_t v) {
+    std::ranges::fill(m_words, broadcast(v));
+    maskTail();
+  }
+
+  ///@{
+  /**
+   * @brief change every cell of the grid.
+   *
+   * The add/sub versions wrap around at 16, the saturating versions stop at 0 and 15.
+   */
+  void add(std::uint8_t v) {
+    auto const b = broadcast(v);
+    for (auto &w : m_words)
+      w = addLanes(w, b);
+    maskTail();
+  }
+  void sub(std::uint8_t v) { add(static_cast<std::uint8_t>(16 - (v & 0xf))); }
+  void addSaturate(std::uint8_t v) {
+    auto const b = broadcast(v);
+    for (auto &w : m_words) {
+      // every lane with a carry becomes 0xf
+      auto const overflow = carries(w, b) >> 3;
+      w = addLanes(w, b) | (overflow * 0xf);
+    }
+    maskTail();
+  }
+  void subSaturate(std::uint8_t v) {
+    // 15 - ((15 - a) +sat v)
+    auto const b = broadcast(v);
+    for (auto &w : m_words) {
+      auto const inv = ~w;
+      auto const overflow = carries(inv, b) >> 3;
+      w = ~(addLanes(inv, b) | (overflow * 0xf));
+    }
+    maskTail();
+  }
+  ///@}
+
+  ///@{
+  /**
+   * @brief combine two grids of the same size, bit by bit
+   * @throws std::invalid_argument if the sizes differ
+   */
+  nibbleGrid &operator&=(const nibbleGrid &other) {
+    combine(other, [](word_type a, word_type b) { return a & b; });
+    return *this;
+  }
+  nibbleGrid &operator|=(const nibbleGrid &other) {
+    combine(other, [](word_type a, word_type b) { return a | b; });
+    return *this;
+  }
+  nibbleGrid &operator^=(const nibbleGrid &other) {
+    combine(other, [](word_type a, word_type b) { return a ^ b; });
+    return *this;
+  }
+  ///@}
+
+  /** @brief count the cells holding a value */
+  [[nodiscard]] std::size_t count(std::uint8_t v) const {
+    auto const b = broadcast(v);
+    return countLanes([b](word_type w) { return equalLanes(w, b); });
+  }
+
+  /** @brief count the cells holding at least a value */
+  [[nodiscard]] std::size_t countAtLeast(std::uint8_t v) const {
+    if ((v & 0xf) == 0)
+      return size();
+    return countLanes([v](word_type w) { return atLeastLanes(w, v); });
+  }
+
+  /**
+   * @brief the mask of all cells holding at least a value
+   */
+  [[nodiscard]] bitGrid atLeast(std::uint8_t v) const {
+    bitGrid out(m_rows, m_columns, (v & 0xf) == 0);
+    if ((v & 0xf) == 0)
+      return out;
+    for (std::size_t i = 0; i < m_words.size(); ++i) {
+      for (auto hits = atLeastLanes(m_words[i], v) & validLanes(i); hits != 0; hits &= hits - 1) {
+        auto const cell = i * Lanes + static_cast<std::size_t>(std::countr_zero(hits)) / 4;
+        out.set(cell % m_columns, cell / m_columns);
+      }
+    }
+    return out;
+  }
+
+  /** @brief copy into a byte sized numericGrid */
+  [[nodiscard]] numericGrid<std::uint8_t> toGrid() const {
+    numericGrid<std::uint8_t> out{m_rows, m_columns};
+    for (std::size_t i = 0; i < size(); ++i)
+      out.data()[i] = static_cast<std::uint8_t>((m_words[i / Lanes] >> shift(i)) & 0xf);
+    return out;
+  }
+
+  /** @brief get the number of cells */
+  [[nodiscard]] std::size_t size() const { return m_rows * m_columns; }
+
+  /** @brief get the number of rows (y) */
+  [[nodiscard]] std::size_t rows() const { return m_rows; }
+
+  /** @brief get the number of columns (x) */
+  [[nodiscard]] std::size_t columns() const { return m_columns; }
+
+  bool operator==(const nibbleGrid &) const = default;
+
+private:
+  static constexpr word_type Low = 0x1111111111111111ULL;
+  static constexpr word_type Seven = 0x7777777777777777ULL;
+  static constexpr word_type High = 0x8888888888888888ULL;
+
+  static constexpr unsigned shift(std::size_t i) { return static_cast<unsigned>(i % Lanes) * 4; }
+  static constexpr word_type broadcast(std::uint8_t v) { return Low * (v & 0xf); }
+
+  /// lane wise a + b, modulo 16
+  static constexpr word_type addLanes(word_type a, word_type b) { return ((a & Seven) + (b & Seven)) ^ ((a ^ b) & High); }
+
+  /// the top bit of each lane is set, if a + b overflows the lane
+  static constexpr word_type carries(word_type a, word_type b) {
+    auto const c = (a & Seven) + (b & Seven);
+    return ((a & b) | ((a ^ b) & c)) & High;
+  }
+
+  /// the top bit of each lane is set, if a == b
+  static constexpr word_type equalLanes(word_type a, word_type b) {
+    auto const x = a ^ b;
+    return ~((x | (x << 1) | (x << 2) | (x << 3)) | Seven);
+  }
+
+  /// the top bit of each lane is set, if a >= v, v must not be 0
+  static constexpr word_type atLeastLanes(word_type a, std::uint8_t v) { return carries(a, broadcast(static_cast<std::uint8_t>(16 - (v & 0xf)))); }
+
+  /// the top bits of all lanes of word i, that hold a cell
+  word_type validLanes(std::size_t i) const {
+    auto const used = size() - i * Lanes;
+    return used >= Lanes ? High : High & ((word_type{1} << (used * 4)) - 1);
+  }
+
+  /**
+   * count the lanes, where `hits(word)` sets the top bit.
+   *
+   * The hits are summed up in nibble counters, that are folded into byte counters before they can overflow. This keeps
+   * the inner loop free of popcount, which is a library call without a popcnt capable target.
+   */
+  template <typename F> std::size_t countLanes(F &&hits) const {
+    if (m_words.empty())
+      return 0;
+    constexpr word_type NibbleMask = 0x0f0f0f0f0f0f0f0fULL, ByteMask = 0x00ff00ff00ff00ffULL;
+    auto const full = m_words.size() - 1;
+    std::size_t n = 0, i = 0;
+    while (i < full) {
+      // 8 rounds of 2 * 15 per byte stay below 256
+      word_type bytes = 0;
+      for (std::size_t r = 0; r < 8 && i < full; ++r) {
+        word_type nibbles = 0;
+        for (std::size_t k = 0; k < 15 && i < full; ++k, ++i)
+          nibbles += hits(m_words[i]) >> 3;
+        bytes += (nibbles & NibbleMask) + ((nibbles >> 4) & NibbleMask);
+      }
+      auto const shorts = (bytes & ByteMask) + ((bytes >> 8) & ByteMask);
+      n += static_cast<std::size_t>((shorts * 0x0001000100010001ULL) >> 48);
+    }
+    return n + static_cast<std::size_t>(std::popcount(hits(m_words.back()) & validLanes(full)));
+  }
+
+  template <typename Op> void combine(const nibbleGrid &other, Op op) {
+    if (other.m_rows != m_rows || other.m_columns != m_columns)
+      throw std::invalid_argument("nibbleGrid: sizes differ");
+    for (std::size_t i = 0; i < m_words.size(); ++i)
+      m_words[i] = op(m_words[i], other.m_words[i]);
+  }
+
+  /// clear the unused lanes of the last word
+  void maskTail() {
+    auto const used = size() % Lanes;
+    if (used != 0)
+      m_words.back() &= (word_type{1} << (used * 4)) - 1;
+  }
+
+  std::size_t m_rows{}, m_columns{};
+  std::vector<word_type> m_words;
+};
+
+} // namespace AoC
+
+#endif // NIBBLEGRID_H
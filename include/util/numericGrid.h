@@ -20,11 +20,23 @@
 #ifndef NUMERICGRID_H
 #define NUMERICGRID_H
 
+#include <algorithm>
+#include <compare>
 #include <cstdint>
 #include <istream>
+#include <iterator>
+#include <span>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include "gridKernels.h"
+#include "mappedFile.h"
+#include "stencil.h"
+
 /**
  * operator to load the a row from a std::istream
  */
@@ -36,10 +48,19 @@ inline std::istream &operator>>(std::istream &is, std::vector<uint_fast8_t> &vec
 
 namespace AoC {
 
+/**
+ * @brief cell type of a grid holding the results of a cell function `R f(...)`
+ *
+ * `std::vector<bool>` has no contiguous storage, so predicates produce `uint8_t` cells instead.
+ */
+template <typename R> using CellResult = std::conditional_t<std::is_same_v<R, bool>, uint8_t, R>;
+
 /**
  * @brief container for AoC typical numeric grids.
  *
- * It stores the input in a two dimensional vector, and provides some basic access functionality, like iterators and column views.
+ * It stores the input in a single row-major buffer, and provides some basic access functionality, like row spans, iterators and column views.
+ *
+ * The flat iterator is a contiguous iterator, so the whole grid can be handed to any std::ranges algorithm as a plain block of memory.
  *
  * @tparam T the storage type for each number. While they are always 8bit (one digit per cell), one may use another storage type in certain cases
  */
@@ -47,14 +68,76 @@ template <typename T = uint_fast8_t> class numericGrid {
 public:
   template <typename vT> class Iterator;
   class ColumnView;
+  template <std::size_t N> class NeighbourView;
+
+  numericGrid() = default;
+
+  /**
+   * @brief create a grid with a fixed size
+   * @param rows number of rows (y)
+   * @param columns number of columns (x)
+   * @param value initial value of each cell
+   */
+  numericGrid(std::size_t rows, std::size_t columns, const T &value = {}) : m_grid(rows * columns, value), m_rows{rows}, m_columns{columns} {}
+
+  /**
+   * @brief create a grid from a buffer holding the whole input.
+   *
+   * Rows and columns are derived from the newline positions, and all digits are decoded in one pass, without any
+   * stream in between. Empty lines and `\r` line endings are ignored.
+   *
+   * @param input the raw puzzle input
+   * @throws std::invalid_argument if the rows differ in length
+   */
+  static numericGrid fromString(std::string_view input) {
+    numericGrid grid;
+    auto const total = input.size();
+    while (!input.empty()) {
+      auto eol = input.find('\n');
+      auto line = input.substr(0, eol);
+      input.remove_prefix(eol == std::string_view::npos ? input.size() : eol + 1);
+      auto const lineBytes = eol == std::string_view::npos ? line.size() : eol + 1;
+      if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+      if (line.empty())
+        continue;
+      if (grid.m_rows == 0) {
+        grid.m_columns = line.size();
+        // every line looks like the first one, this is exact unless there are empty lines
+        grid.m_grid.reserve((total + lineBytes - 1) / lineBytes * grid.m_columns);
+      } else if (line.size() != grid.m_columns)
+        throw std::invalid_argument("numericGrid: rows differ in length");
+
+      auto offset = grid.m_grid.size();
+      grid.m_grid.resize(offset + line.size());
+      kernels::decodeDigits(line.data(), grid.m_grid.data() + offset, line.size());
+      ++grid.m_rows;
+    }
+    return grid;
+  }
+
+  /**
+   * @brief create a grid from a file.
+   *
+   * The file is loaded through MappedFile, and decoded with fromString().
+   *
+   * @param filename the file to load
+   * @throws std::system_error if the file can not be read
+   */
+  static numericGrid fromFile(const std::string &filename) {
+    MappedFile file{filename};
+    return fromString(file.view());
+  }
 
+  ///@{
   /**
    * @brief access a specific row
    * @param idx row to access
-   * @return the row vector
+   * @return a span over the row
    */
-  std::vector<T> &operator[](std::size_t idx) { return m_grid[idx]; }
-  const std::vector<T> &operator[](std::size_t idx) const { return m_grid[idx]; }
+  std::span<T> operator[](std::size_t idx) { return {m_grid.data() + idx * m_columns, m_columns}; }
+  std::span<const T> operator[](std::size_t idx) const { return {m_grid.data() + idx * m_columns, m_columns}; }
+  ///@}
 
   ///@{
   /**
@@ -65,13 +148,13 @@ public:
   T &operator[](const std::pair<size_t, size_t> &idx) {
     // TODO: bounds check?
     //   std::vector does no bounds checking, should we?
-    return m_grid[idx.second][idx.first];
+    return m_grid[idx.second * m_columns + idx.first];
   }
 
   const T &operator[](const std::pair<size_t, size_t> &idx) const {
     // TODO: bounds check?
     //   std::vector does no bounds checking, should we?
-    return m_grid[idx.second][idx.first];
+    return m_grid[idx.second * m_columns + idx.first];
   }
   ///@}
 
@@ -79,79 +162,174 @@ public:
    * @brief get a view for a specific column
    * @param idx the column
    */
-  ColumnView column(std::size_t idx) {
-    return { this,idx };
+  ColumnView column(std::size_t idx) { return {this, idx}; }
+
+  /**
+   * @brief a transposed copy of the grid
+   *
+   * Row `x` of the result is column `x` of this grid, as one contiguous span. Use this instead of column() for
+   * algorithms, that walk every column. The copy is cache blocked, see kernels::transpose().
+   */
+  [[nodiscard]] numericGrid transposed() const {
+    numericGrid out{m_columns, m_rows};
+    kernels::transpose(m_grid.data(), out.m_grid.data(), m_rows, m_columns);
+    return out;
   }
 
+  ///@{
+  /**
+   * @brief get the positions of all neighbours of a cell, that are inside the grid
+   * @param pos a pair of x,y
+   * @param stencil the neighbour offsets to visit
+   * @return a range of x,y pairs
+   *
+   * These ranges do a bounds check for every neighbour. For hot loops over the whole grid, have a look at paddedGrid.
+   */
+  template <std::size_t N> NeighbourView<N> neighbours(const std::pair<size_t, size_t> &pos, const Stencil<N> &stencil) const {
+    return {pos, stencil, m_columns, m_rows};
+  }
+  NeighbourView<4> neighbours4(const std::pair<size_t, size_t> &pos) const { return neighbours(pos, stencil4); }
+  NeighbourView<8> neighbours8(const std::pair<size_t, size_t> &pos) const { return neighbours(pos, stencil8); }
+  ///@}
+
+  ///@{
+  /**
+   * @brief direct access to the underlying row-major buffer
+   */
+  T *data() { return m_grid.data(); }
+  const T *data() const { return m_grid.data(); }
+  ///@}
+
   ///@{
   /**
    * @brief get an iterator pointing to the start of the grid
    */
-  Iterator<T> begin() { return Iterator<T>{this}; }
-  [[nodiscard]] Iterator<const T> begin() const { return Iterator<const T>{this}; }
+  Iterator<T> begin() { return {m_grid.data(), m_grid.data() + m_grid.size()}; }
+  [[nodiscard]] Iterator<const T> begin() const { return {m_grid.data(), m_grid.data() + m_grid.size()}; }
   [[nodiscard]] Iterator<const T> cbegin() const { return begin(); }
   ///@}
 
   ///@{
   /**
-   * @brief get the end sentinel for the iterator
+   * @brief get an iterator pointing past the end of the grid
+   *
+   * The iterators still compare equal to std::default_sentinel_t when they reach the end.
    */
-  static std::default_sentinel_t end() { return {}; }
-  static std::default_sentinel_t cend() { return {}; }
+  Iterator<T> end() { return {m_grid.data() + m_grid.size(), m_grid.data() + m_grid.size()}; }
+  [[nodiscard]] Iterator<const T> end() const { return {m_grid.data() + m_grid.size(), m_grid.data() + m_grid.size()}; }
+  [[nodiscard]] Iterator<const T> cend() const { return end(); }
   ///@}
 
   /**
    * @brief get the number of elements.
    *
-   * @warning It is assumed, that the each row inside the grid has the same
-   * length. This is a very save assumption for AoC, but in the "real world" ...
-   *
-   * @return the number of elements inside the vector
+   * @return the number of elements inside the grid
    */
-  std::size_t size() const {
-    if (m_grid.empty())
-      return 0;
-    return m_grid.size() * m_grid[0].size();
-  }
+  std::size_t size() const { return m_grid.size(); }
+
+  /**
+   * @brief true if the grid holds no elements
+   */
+  [[nodiscard]] bool empty() const { return m_grid.empty(); }
 
   /**
    * @brief get the number of rows (y).
    */
-  std::size_t rows() const { return m_grid.size(); }
+  std::size_t rows() const { return m_rows; }
 
   /**
    * @brief the the number of columns (x).
    *
    * @see size()
    */
-  std::size_t columns() const {
-    if (m_grid.empty())
-      return 0;
-    return m_grid[0].size();
+  std::size_t columns() const { return m_columns; }
+
+  ///@{
+  /**
+   * @brief change every cell of the grid.
+   *
+   * The add/sub versions wrap around, the saturating versions stop at the limits of `T`.
+   * For byte sized cells these run on the vector kernels of AoC::kernels.
+   */
+  void add(T v) { kernels::add(m_grid.data(), m_grid.size(), v); }
+  void sub(T v) { kernels::sub(m_grid.data(), m_grid.size(), v); }
+  void addSaturate(T v) { kernels::addSaturate(m_grid.data(), m_grid.size(), v); }
+  void subSaturate(T v) { kernels::subSaturate(m_grid.data(), m_grid.size(), v); }
+  void clamp(T lo, T hi) { kernels::clamp(m_grid.data(), m_grid.size(), lo, hi); }
+  ///@}
+
+  ///@{
+  /**
+   * @brief count the cells matching a value, a threshold or a predicate
+   */
+  [[nodiscard]] std::size_t count(T v) const { return kernels::countEqual(m_grid.data(), m_grid.size(), v); }
+  [[nodiscard]] std::size_t countAtLeast(T v) const { return kernels::countAtLeast(m_grid.data(), m_grid.size(), v); }
+  template <typename Pred> [[nodiscard]] std::size_t countIf(Pred &&pred) const {
+    return static_cast<std::size_t>(std::count_if(m_grid.begin(), m_grid.end(), std::forward<Pred>(pred)));
+  }
+  ///@}
+
+  ///@{
+  /**
+   * @brief find the first cell (in row-major order) reaching a threshold or matching a predicate
+   * @return an iterator to the cell, or end()
+   */
+  Iterator<T> findAtLeast(T v) { return begin() + static_cast<std::ptrdiff_t>(kernels::findAtLeast(m_grid.data(), m_grid.size(), v)); }
+  [[nodiscard]] Iterator<const T> findAtLeast(T v) const {
+    return begin() + static_cast<std::ptrdiff_t>(kernels::findAtLeast(m_grid.data(), m_grid.size(), v));
+  }
+  template <typename Pred> Iterator<T> findIf(Pred &&pred) {
+    return begin() + (std::find_if(m_grid.begin(), m_grid.end(), std::forward<Pred>(pred)) - m_grid.begin());
   }
+  template <typename Pred> [[nodiscard]] Iterator<const T> findIf(Pred &&pred) const {
+    return begin() + (std::find_if(m_grid.begin(), m_grid.end(), std::forward<Pred>(pred)) - m_grid.begin());
+  }
+  ///@}
 
-  /** operator to load a whole grid from a std::istream */
+  /**
+   * @brief two grids are equal, if they have the same dimensions and values
+   */
+  bool operator==(const numericGrid &) const = default;
+
+  /**
+   * @brief operator to load a whole grid from a std::istream
+   *
+   * Rows are appended to the grid. The first row defines the number of columns, a row with a different length sets the
+   * `failbit` of the stream. Empty lines and `\r` line endings are ignored, like for fromString().
+   */
   friend std::istream &operator>>(std::istream &is, numericGrid &map) {
     std::string line;
     while (std::getline(is, line)) {
-      std::vector<uint_fast8_t> row;
-      std::istringstream s{line};
-      s >> row;
-      map.m_grid.emplace_back(std::move(row));
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+      if (line.empty())
+        continue;
+      if (map.m_rows == 0)
+        map.m_columns = line.size();
+      else if (line.size() != map.m_columns) {
+        is.setstate(std::ios::failbit);
+        break;
+      }
+      auto offset = map.m_grid.size();
+      map.m_grid.resize(offset + map.m_columns);
+      kernels::decodeDigits(line.data(), map.m_grid.data() + offset, map.m_columns);
+      ++map.m_rows;
     }
     return is;
   }
 
 private:
-  template <typename vT> friend class Iterator;
-  std::vector<std::vector<T>> m_grid;
+  std::vector<T> m_grid;
+  std::size_t m_rows{}, m_columns{};
 };
 
 template <typename T> template <typename vT> class numericGrid<T>::Iterator {
 public:
   using iterator_category = std::random_access_iterator_tag;
+  using iterator_concept = std::contiguous_iterator_tag;
   using difference_type = std::ptrdiff_t;
-  using value_type = vT;
+  using value_type = std::remove_cv_t<vT>;
+  using element_type = vT;
   using pointer = vT *;
   using reference = vT &;
 
@@ -163,22 +341,20 @@ public:
   Iterator &operator=(const Iterator &) = default;
   Iterator &operator=(Iterator &&) noexcept = default;
 
+  /** a mutable iterator converts to a const one */
+  template <typename oT>
+  requires(std::is_const_v<vT> && std::is_same_v<std::remove_cv_t<vT>, oT>) Iterator(const Iterator<oT> &o) : m_cIt{o.m_cIt}, m_cEnd{o.m_cEnd} {}
+
   reference operator*() const { return *m_cIt; }
-  pointer operator->() { return &(*m_cIt); }
+  pointer operator->() const { return m_cIt; }
+  reference operator[](difference_type n) const { return m_cIt[n]; }
 
   bool operator==(const Iterator &o) const { return m_cIt == o.m_cIt; }
-  bool operator==(std::default_sentinel_t) const { return m_rowsIt == m_rowsEnd && m_cIt == m_cEnd; }
-  bool operator<(const Iterator &o) const { return m_rowsIt == o.m_rowsIt ? m_cIt < o.m_cIt : m_rowsIt < o.m_rowsIt; }
+  bool operator==(std::default_sentinel_t) const { return m_cIt == m_cEnd; }
+  auto operator<=>(const Iterator &o) const { return m_cIt <=> o.m_cIt; }
 
   Iterator &operator++() {
     ++m_cIt;
-    if (m_cIt == m_cEnd) {
-      ++m_rowsIt;
-      if (m_rowsIt != m_rowsEnd) {
-        m_cIt = m_rowsIt->begin();
-        m_cEnd = m_rowsIt->end();
-      }
-    }
     return *this;
   }
 
@@ -188,16 +364,38 @@ public:
     return tmp;
   }
 
+  Iterator &operator--() {
+    --m_cIt;
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    auto tmp = *this;
+    --(*this);
+    return tmp;
+  }
+
+  Iterator &operator+=(difference_type n) {
+    m_cIt += n;
+    return *this;
+  }
+
+  Iterator &operator-=(difference_type n) {
+    m_cIt -= n;
+    return *this;
+  }
+
+  Iterator operator+(difference_type n) const { return {m_cIt + n, m_cEnd}; }
+  friend Iterator operator+(difference_type n, const Iterator &it) { return it + n; }
+  Iterator operator-(difference_type n) const { return {m_cIt - n, m_cEnd}; }
+  difference_type operator-(const Iterator &o) const { return m_cIt - o.m_cIt; }
+
 private:
   friend class numericGrid<T>;
-  explicit Iterator(numericGrid<T> *parent)
-      : m_parent{parent}, m_rowsIt{parent->m_grid.begin()}, m_rowsEnd{parent->m_grid.end()}, m_cIt{parent->m_grid.begin()->begin()},
-        m_cEnd{parent->m_grid.begin()->end()} {}
+  template <typename oT> friend class Iterator;
+  Iterator(vT *it, vT *end) : m_cIt{it}, m_cEnd{end} {}
 
-  numericGrid<T> *m_parent{};
-
-  typename std::vector<std::vector<T>>::iterator m_rowsIt{}, m_rowsEnd{};
-  typename std::vector<T>::iterator m_cIt{}, m_cEnd{};
+  vT *m_cIt{}, *m_cEnd{};
 };
 
 template <typename T> class numericGrid<T>::ColumnView {
@@ -206,7 +404,7 @@ public:
   public:
     using iterator_category = std::random_access_iterator_tag;
     using difference_type = std::ptrdiff_t;
-    using value_type = vT;
+    using value_type = std::remove_cv_t<vT>;
     using pointer = vT *;
     using reference = vT &;
 
@@ -218,15 +416,16 @@ public:
     Iterator &operator=(const Iterator &) = default;
     Iterator &operator=(Iterator &&) noexcept = default;
 
-    bool operator==(const Iterator &o) const { return m_cIt == o.m_cIt; }
-    bool operator==(std::default_sentinel_t) const { return m_cIt == m_end; }
-    bool operator<(const Iterator &o) const { return m_cIt < o.m_cIt; }
+    bool operator==(const Iterator &o) const { return m_row == o.m_row; }
+    bool operator==(std::default_sentinel_t) const { return m_row == m_rows; }
+    auto operator<=>(const Iterator &o) const { return m_row <=> o.m_row; }
 
-    reference operator*() const { return (*m_cIt)[m_column]; }
-    pointer operator->() { return &((*m_cIt)[m_column]); }
+    reference operator*() const { return m_base[m_row * m_stride]; }
+    pointer operator->() const { return &m_base[m_row * m_stride]; }
+    reference operator[](difference_type n) const { return m_base[(m_row + n) * m_stride]; }
 
     Iterator &operator++() {
-      ++m_cIt;
+      ++m_row;
       return *this;
     }
 
@@ -236,13 +435,44 @@ public:
       return tmp;
     }
 
+    Iterator &operator--() {
+      --m_row;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    Iterator &operator+=(difference_type n) {
+      m_row += n;
+      return *this;
+    }
+
+    Iterator &operator-=(difference_type n) {
+      m_row -= n;
+      return *this;
+    }
+
+    Iterator operator+(difference_type n) const {
+      auto tmp = *this;
+      return tmp += n;
+    }
+    friend Iterator operator+(difference_type n, const Iterator &it) { return it + n; }
+    Iterator operator-(difference_type n) const {
+      auto tmp = *this;
+      return tmp -= n;
+    }
+    difference_type operator-(const Iterator &o) const { return m_row - o.m_row; }
+
   private:
     friend class ColumnView;
-    Iterator(const typename std::vector<std::vector<T>>::iterator &begin, const typename std::vector<std::vector<T>>::iterator &end, std::size_t column)
-        : m_cIt{begin}, m_end{end},m_column{column} {}
+    Iterator(vT *base, difference_type stride, difference_type row, difference_type rows) : m_base{base}, m_stride{stride}, m_row{row}, m_rows{rows} {}
 
-    typename std::vector<std::vector<T>>::iterator m_cIt{}, m_end{};
-    size_t m_column;
+    vT *m_base{};
+    difference_type m_stride{}, m_row{}, m_rows{};
   };
 
   ColumnView(const ColumnView &) = default;
@@ -251,30 +481,111 @@ public:
   ColumnView &operator=(const ColumnView &) = default;
   ColumnView &operator=(ColumnView &&) noexcept = default;
 
-  T &operator[](std::size_t idx) { return m_parent->m_grid[idx][m_column]; }
+  T &operator[](std::size_t idx) { return m_parent->m_grid[idx * m_parent->m_columns + m_column]; }
 
-  const T &operator[](std::size_t idx) const { return m_parent->m_grid[idx][m_column]; }
+  const T &operator[](std::size_t idx) const { return m_parent->m_grid[idx * m_parent->m_columns + m_column]; }
 
-  Iterator<T> begin() { return Iterator<T>{m_parent->m_grid.begin(), m_parent->m_grid.end(), m_column}; }
-  [[nodiscard]] Iterator<const T> begin() const { return {m_parent->m_grid.begin(), m_parent->m_grid.end(), m_column}; }
+  Iterator<T> begin() { return iter<T>(0); }
+  [[nodiscard]] Iterator<const T> begin() const { return iter<const T>(0); }
   [[nodiscard]] Iterator<const T> cbegin() const { return begin(); }
 
-  static std::default_sentinel_t end() { return {}; }
+  Iterator<T> end() { return iter<T>(m_parent->m_rows); }
+  [[nodiscard]] Iterator<const T> end() const { return iter<const T>(m_parent->m_rows); }
+  [[nodiscard]] Iterator<const T> cend() const { return end(); }
+
+  /** @brief number of cells in the column */
+  std::size_t size() const { return m_parent->m_rows; }
 
 private:
   friend class numericGrid<T>;
   ColumnView(numericGrid<T> *parent, std::size_t column) : m_parent{parent}, m_column{column} {}
 
+  template <typename vT> Iterator<vT> iter(std::size_t row) const {
+    return {m_parent->m_grid.data() + m_column, static_cast<std::ptrdiff_t>(m_parent->m_columns), static_cast<std::ptrdiff_t>(row),
+            static_cast<std::ptrdiff_t>(m_parent->m_rows)};
+  }
+
   numericGrid<T> *m_parent{};
   std::size_t m_column{};
 };
 
-static_assert(std::forward_iterator<numericGrid<uint_fast8_t>::Iterator<uint_fast8_t>>);
-static_assert(std::forward_iterator<numericGrid<uint_fast8_t>::Iterator<const uint_fast8_t>>);
-static_assert(std::forward_iterator<numericGrid<uint_fast8_t>::ColumnView::Iterator<const uint_fast8_t>>);
+/**
+ * @brief range over the in-bounds neighbour positions of one cell
+ *
+ * @tparam N the stencil size
+ */
+template <typename T> template <std::size_t N> class numericGrid<T>::NeighbourView {
+public:
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::pair<std::size_t, std::size_t>;
+    using pointer = const value_type *;
+    using reference = value_type;
+
+    Iterator() = default;
+
+    value_type operator*() const {
+      auto [dx, dy] = m_view->m_stencil[m_idx];
+      return {m_view->m_pos.first + dx, m_view->m_pos.second + dy};
+    }
+
+    bool operator==(const Iterator &o) const { return m_idx == o.m_idx; }
+    bool operator==(std::default_sentinel_t) const { return m_idx == N; }
+
+    Iterator &operator++() {
+      ++m_idx;
+      skip();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+  private:
+    friend class NeighbourView;
+    explicit Iterator(const NeighbourView *view) : m_view{view} { skip(); }
+
+    void skip() {
+      while (m_idx < N && !m_view->inside(m_view->m_stencil[m_idx]))
+        ++m_idx;
+    }
+
+    const NeighbourView *m_view{};
+    std::size_t m_idx{};
+  };
+
+  [[nodiscard]] Iterator begin() const { return Iterator{this}; }
+  static std::default_sentinel_t end() { return {}; }
+
+private:
+  friend class numericGrid<T>;
+  NeighbourView(std::pair<std::size_t, std::size_t> pos, const Stencil<N> &stencil, std::size_t columns, std::size_t rows)
+      : m_pos{pos}, m_stencil{stencil}, m_columns{columns}, m_rows{rows} {}
+
+  [[nodiscard]] bool inside(const Offset &o) const {
+    // unsigned wrap around turns negative positions into huge ones
+    return m_pos.first + o.first < m_columns && m_pos.second + o.second < m_rows;
+  }
+
+  std::pair<std::size_t, std::size_t> m_pos;
+  Stencil<N> m_stencil;
+  std::size_t m_columns, m_rows;
+};
+
+static_assert(std::contiguous_iterator<numericGrid<uint_fast8_t>::Iterator<uint_fast8_t>>);
+static_assert(std::contiguous_iterator<numericGrid<uint_fast8_t>::Iterator<const uint_fast8_t>>);
+static_assert(std::random_access_iterator<numericGrid<uint_fast8_t>::ColumnView::Iterator<uint_fast8_t>>);
+static_assert(std::random_access_iterator<numericGrid<uint_fast8_t>::ColumnView::Iterator<const uint_fast8_t>>);
 
-static_assert(std::ranges::forward_range<numericGrid<uint_fast8_t>>);
-static_assert(std::ranges::forward_range<numericGrid<uint_fast8_t>::ColumnView>);
+static_assert(std::ranges::contiguous_range<numericGrid<uint_fast8_t>>);
+static_assert(std::ranges::sized_range<numericGrid<uint_fast8_t>>);
+static_assert(std::ranges::random_access_range<numericGrid<uint_fast8_t>::ColumnView>);
+static_assert(std::ranges::forward_range<numericGrid<uint_fast8_t>::NeighbourView<8>>);
 
 } // namespace AoC
 
@@ -0,0 +1,175 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PADDEDGRID_H
+#define PADDEDGRID_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "numericGrid.h"
+#include "stencil.h"
+
+namespace AoC {
+
+/**
+ * @brief a numeric grid surrounded by a border of sentinel cells.
+ *
+ * Every cell inside the grid has all of its neighbours (up to the padding width) in memory, so neighbour access is a
+ * plain pointer offset, without any bounds check. The border cells hold a sentinel value, that the caller chooses to be
+ * neutral for the problem (e.g. 0 for "count the lit neighbours", or the maximum for "find a lower neighbour").
+ *
+ * All positions are given in the coordinates of the unpadded grid.
+ *
+ * @tparam T the storage type for each cell
+ */
+template <typename T = uint_fast8_t> class paddedGrid {
+public:
+  paddedGrid() = default;
+
+  /**
+   * @brief create an padded copy of a grid
+   * @param grid the source grid
+   * @param sentinel the value of the border cells
+   * @param padding the width of the border, has to cover the reach of all stencils used
+   */
+  explicit paddedGrid(const numericGrid<T> &grid, T sentinel = {}, std::size_t padding = 1)
+      : m_rows{grid.rows()}, m_columns{grid.columns()}, m_padding{padding}, m_stride{grid.columns() + 2 * padding},
+        m_grid((grid.rows() + 2 * padding) * m_stride, sentinel) {
+    for (std::size_t y = 0; y < m_rows; ++y)
+      std::ranges::copy(grid[y], m_grid.begin() + static_cast<std::ptrdiff_t>(index({0, static_cast<std::ptrdiff_t>(y)})));
+  }
+
+  ///@{
+  /**
+   * @brief get a value by position
+   * @param idx a pair of x,y. Positions up to the padding width outside of the grid are valid, and return the border.
+   */
+  T &operator[](const std::pair<std::ptrdiff_t, std::ptrdiff_t> &idx) { return m_grid[index(idx)]; }
+  const T &operator[](const std::pair<std::ptrdiff_t, std::ptrdiff_t> &idx) const { return m_grid[index(idx)]; }
+  ///@}
+
+  /**
+   * @brief the buffer index of a position
+   */
+  [[nodiscard]] std::size_t index(const std::pair<std::ptrdiff_t, std::ptrdiff_t> &idx) const {
+    return static_cast<std::size_t>((idx.second + static_cast<std::ptrdiff_t>(m_padding)) * static_cast<std::ptrdiff_t>(m_stride) + idx.first +
+                                    static_cast<std::ptrdiff_t>(m_padding));
+  }
+
+  /**
+   * @brief translate a stencil into buffer offsets
+   */
+  template <std::size_t N> [[nodiscard]] std::array<std::ptrdiff_t, N> offsets(const Stencil<N> &stencil) const {
+    std::array<std::ptrdiff_t, N> out{};
+    for (std::size_t i = 0; i < N; ++i)
+      out[i] = stencil[i].second * static_cast<std::ptrdiff_t>(m_stride) + stencil[i].first;
+    return out;
+  }
+
+  /**
+   * @brief invoke `f(T &neighbour)` for every neighbour of a cell, without any bounds check
+   *
+   * The reach of the stencil has to fit into the padding, this is only asserted.
+   */
+  template <std::size_t N, typename F> void forEachNeighbour(const std::pair<std::ptrdiff_t, std::ptrdiff_t> &pos, const Stencil<N> &stencil, F &&f) {
+    assert(stencilReach(stencil) <= m_padding && "paddedGrid: stencil reaches beyond the padding");
+    auto const offs = offsets(stencil);
+    T *cell = m_grid.data() + index(pos);
+    for (auto o : offs)
+      f(cell[o]);
+  }
+
+  /**
+   * @brief apply a stencil to the whole grid.
+   *
+   * `f(const T &cell, const std::array<T, N> &neighbours)` is invoked for every cell inside the grid, and its results
+   * form the returned grid, `bool` results are stored as `uint8_t` (see CellResult). The inner loop has a fixed trip
+   * count and no bounds checks, so the compiler is free to unroll and vectorize it.
+   *
+   * @param stencil the neighbours to gather
+   * @param f the cell function
+   * @return a grid of the results, with the size of the unpadded grid
+   * @throws std::invalid_argument if the stencil reaches further than the padding
+   */
+  template <std::size_t N, typename F, typename R = std::invoke_result_t<F, const T &, const std::array<T, N> &>>
+  numericGrid<CellResult<R>> apply(const Stencil<N> &stencil, F &&f) const {
+    if (stencilReach(stencil) > m_padding)
+      throw std::invalid_argument("paddedGrid: stencil reaches beyond the padding");
+    auto const offs = offsets(stencil);
+    numericGrid<CellResult<R>> out{m_rows, m_columns};
+    for (std::size_t y = 0; y < m_rows; ++y) {
+      const T *row = m_grid.data() + index({0, static_cast<std::ptrdiff_t>(y)});
+      auto dst = out[y];
+      for (std::size_t x = 0; x < m_columns; ++x) {
+        std::array<T, N> n;
+        for (std::size_t i = 0; i < N; ++i)
+          n[i] = row[static_cast<std::ptrdiff_t>(x) + offs[i]];
+        dst[x] = f(row[x], n);
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @brief copy the inner cells back into a numericGrid
+   */
+  [[nodiscard]] numericGrid<T> toGrid() const {
+    numericGrid<T> out{m_rows, m_columns};
+    for (std::size_t y = 0; y < m_rows; ++y) {
+      auto const begin = m_grid.begin() + static_cast<std::ptrdiff_t>(index({0, static_cast<std::ptrdiff_t>(y)}));
+      std::copy(begin, begin + static_cast<std::ptrdiff_t>(m_columns), out[y].begin());
+    }
+    return out;
+  }
+
+  ///@{
+  /**
+   * @brief direct access to the underlying buffer, including the border
+   */
+  T *data() { return m_grid.data(); }
+  const T *data() const { return m_grid.data(); }
+  ///@}
+
+  /** @brief get the number of rows (y), without the border */
+  std::size_t rows() const { return m_rows; }
+
+  /** @brief get the number of columns (x), without the border */
+  std::size_t columns() const { return m_columns; }
+
+  /** @brief the width of the border */
+  std::size_t padding() const { return m_padding; }
+
+  /** @brief distance between two rows in the buffer */
+  std::size_t stride() const { return m_stride; }
+
+private:
+  std::size_t m_rows{}, m_columns{}, m_padding{}, m_stride{};
+  std::vector<T> m_grid;
+};
+
+} // namespace AoC
+
+#endif // PADDEDGRID_H
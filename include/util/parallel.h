@@ -0,0 +1,261 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace AoC {
+
+/**
+ * @brief the number of worker threads used, if none is given
+ */
+inline unsigned defaultThreads() {
+  auto const n = std::thread::hardware_concurrency();
+  return n ? n : 1;
+}
+
+/**
+ * @brief the number of workers parallelFor() will start for a job
+ *
+ * @param count number of work items
+ * @param threads requested number of threads, 0 for defaultThreads()
+ */
+inline unsigned workerCount(std::size_t count, unsigned threads = 0) {
+  if (threads == 0)
+    threads = defaultThreads();
+  return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, count)));
+}
+
+namespace detail {
+
+/// the work items of one parallelFor() call, shared by all workers
+template <typename F> class ForJob {
+public:
+  ForJob(std::size_t count, F &fn) : m_count{count}, m_fn{fn} {}
+
+  /// run items until there are none left, or one of them threw
+  void work(unsigned worker) {
+    try {
+      for (std::size_t i; (i = m_next.fetch_add(1, std::memory_order_relaxed)) < m_count;)
+        m_fn(worker, i);
+    } catch (...) {
+      std::lock_guard lock{m_errorLock};
+      if (!m_error)
+        m_error = std::current_exception();
+      m_next.store(m_count, std::memory_order_relaxed);
+    }
+  }
+
+  /// rethrow the first exception of any worker
+  void finish() {
+    if (m_error)
+      std::rethrow_exception(m_error);
+  }
+
+private:
+  std::size_t m_count;
+  F &m_fn;
+  std::atomic<std::size_t> m_next{0};
+  std::exception_ptr m_error;
+  std::mutex m_errorLock;
+};
+
+} // namespace detail
+
+/**
+ * @brief run `fn(worker, index)` for every index in `[0, count)` on a set of worker threads.
+ *
+ * The indices are handed out one by one, so uneven work items are balanced between the workers. `worker` is the number
+ * of the calling worker, in `[0, workerCount(count, threads))`. It can be used to pick per worker state, that has to be
+ * reused between work items. The calling thread is worker 0.
+ *
+ * If `fn` throws, no new items are started, and the first exception is rethrown after all workers are done.
+ *
+ * The threads are started for this call, and joined before it returns. That costs some tens of microseconds, for
+ * repeated small jobs use a WorkerPool instead.
+ *
+ * @param count number of work items
+ * @param fn the work function
+ * @param threads number of threads, 0 for defaultThreads()
+ */
+template <typename F> void parallelFor(std::size_t count, F &&fn, unsigned threads = 0) {
+  auto const workers = workerCount(count, threads);
+  if (workers == 1) {
+    for (std::size_t i = 0; i < count; ++i)
+      fn(0u, i);
+    return;
+  }
+
+  detail::ForJob<F> job{count, fn};
+  {
+    std::vector<std::jthread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; ++w)
+      pool.emplace_back([&job, w] { job.work(w); });
+    job.work(0);
+  }
+  job.finish();
+}
+
+/**
+ * @class WorkerPool
+ * @brief a fixed set of worker threads, that is kept between jobs.
+ *
+ * The threads are started once, and wait on a condition variable for the next job, so a job only costs a wake up
+ * instead of a thread start. parallelFor() has the same contract as the free function: the calling thread is worker 0
+ * and takes part in the work.
+ *
+ * One job runs at a time, calls from several threads are serialized. A parallelFor() from inside a job of the same
+ * pool runs on the calling worker alone, instead of waiting for itself.
+ */
+class WorkerPool {
+public:
+  /**
+   * @brief start the workers
+   * @param threads number of workers including the calling thread, 0 for defaultThreads()
+   */
+  explicit WorkerPool(unsigned threads = 0) : m_size{threads ? threads : defaultThreads()} {
+    m_threads.reserve(m_size - 1);
+    for (unsigned w = 1; w < m_size; ++w)
+      m_threads.emplace_back([this, w] { loop(w); });
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  ~WorkerPool() {
+    {
+      std::lock_guard lock{m_lock};
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    m_threads.clear();
+  }
+
+  /** @brief the number of workers, including the calling thread */
+  [[nodiscard]] unsigned size() const { return m_size; }
+
+  /**
+   * @brief run `fn(worker, index)` for every index in `[0, count)` on the pool
+   *
+   * @param count number of work items
+   * @param fn the work function
+   * @param threads the maximum number of workers to use, 0 for all of the pool
+   * @see AoC::parallelFor()
+   */
+  template <typename F> void parallelFor(std::size_t count, F &&fn, unsigned threads = 0) {
+    auto const workers = workerCount(count, threads ? std::min(threads, m_size) : m_size);
+    if (workers == 1 || t_current == this) {
+      for (std::size_t i = 0; i < count; ++i)
+        fn(0u, i);
+      return;
+    }
+
+    detail::ForJob<F> job{count, fn};
+    std::lock_guard submit{m_submit};
+    {
+      std::lock_guard lock{m_lock};
+      m_run = [](void *ctx, unsigned worker) { static_cast<detail::ForJob<F> *>(ctx)->work(worker); };
+      m_job = &job;
+      m_workers = workers;
+      m_pending = workers - 1;
+      ++m_generation;
+    }
+    m_wake.notify_all();
+
+    auto const outer = std::exchange(t_current, this);
+    job.work(0);
+    t_current = outer;
+
+    {
+      std::unique_lock lock{m_lock};
+      m_done.wait(lock, [this] { return m_pending == 0; });
+    }
+    job.finish();
+  }
+
+private:
+  void loop(unsigned worker) {
+    t_current = this;
+    std::uint64_t seen = 0;
+    for (;;) {
+      void (*run)(void *, unsigned);
+      void *job;
+      {
+        std::unique_lock lock{m_lock};
+        m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+        if (m_stop)
+          return;
+        seen = m_generation;
+        if (worker >= m_workers)
+          continue;
+        run = m_run;
+        job = m_job;
+      }
+      run(job, worker);
+      {
+        std::lock_guard lock{m_lock};
+        if (--m_pending == 0)
+          m_done.notify_one();
+      }
+    }
+  }
+
+  /// the pool, whose job the current thread is working on
+  static inline thread_local const WorkerPool *t_current = nullptr;
+
+  unsigned m_size;
+  std::mutex m_submit;
+
+  std::mutex m_lock;
+  std::condition_variable m_wake, m_done;
+  bool m_stop{false};
+  std::uint64_t m_generation{};
+  void (*m_run)(void *, unsigned){};
+  void *m_job{};
+  unsigned m_workers{}, m_pending{};
+
+  // last, so the threads are joined before anything else is destroyed
+  std::vector<std::jthread> m_threads;
+};
+
+/**
+ * @brief a WorkerPool with defaultThreads() workers, shared by the whole process
+ *
+ * It is started on first use.
+ */
+inline WorkerPool &sharedPool() {
+  static WorkerPool pool;
+  return pool;
+}
+
+} // namespace AoC
+
+#endif // PARALLEL_H
@@ -0,0 +1,172 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PARALLELGRID_H
+#define PARALLELGRID_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "numericGrid.h"
+#include "parallel.h"
+
+namespace AoC {
+
+/**
+ * @brief approximate number of cells per work item of the parallel grid algorithms
+ *
+ * Grids with fewer cells than this are handled by the calling thread alone.
+ */
+inline constexpr std::size_t RowBlockCells = std::size_t{1} << 14;
+
+/**
+ * @brief the number of rows per work item for a grid width
+ */
+inline std::size_t rowsPerBlock(std::size_t columns) { return std::max<std::size_t>(1, RowBlockCells / std::max<std::size_t>(columns, 1)); }
+
+/**
+ * @brief run `fn(worker, firstRow, lastRow)` for blocks of rows on the sharedPool()
+ *
+ * Each block covers the rows `[firstRow, lastRow)`. Blocks are sized to about RowBlockCells cells, so each work item is
+ * big enough to hide the scheduling, and every worker touches its own rows only. A grid of a single block runs on the
+ * calling thread without waking the pool.
+ *
+ * @param rows number of rows
+ * @param columns number of columns
+ * @param fn the work function
+ * @param threads the maximum number of threads, 0 for all threads of the pool
+ */
+template <typename F> void parallelRows(std::size_t rows, std::size_t columns, F &&fn, unsigned threads = 0) {
+  auto const block = rowsPerBlock(columns);
+  auto const blocks = (rows + block - 1) / block;
+  if (blocks <= 1) {
+    if (rows)
+      fn(0u, std::size_t{0}, rows);
+    return;
+  }
+  sharedPool().parallelFor(
+      blocks, [&](unsigned worker, std::size_t b) { fn(worker, b * block, std::min(rows, (b + 1) * block)); }, threads);
+}
+
+/**
+ * @brief invoke `f(T &cell)` for every cell of the grid, in parallel
+ */
+template <typename T, typename F> void parallelForEach(numericGrid<T> &grid, F &&f, unsigned threads = 0) {
+  parallelRows(
+      grid.rows(), grid.columns(),
+      [&](unsigned, std::size_t first, std::size_t last) {
+        T *cells = grid.data();
+        for (std::size_t i = first * grid.columns(); i < last * grid.columns(); ++i)
+          f(cells[i]);
+      },
+      threads);
+}
+
+/**
+ * @brief invoke `f(std::span<T> row, std::size_t y)` for every row of the grid, in parallel
+ */
+template <typename T, typename F> void parallelForEachRow(numericGrid<T> &grid, F &&f, unsigned threads = 0) {
+  parallelRows(
+      grid.rows(), grid.columns(),
+      [&](unsigned, std::size_t first, std::size_t last) {
+        for (std::size_t y = first; y < last; ++y)
+          f(grid[y], y);
+      },
+      threads);
+}
+
+/**
+ * @brief map every cell of a grid into a new grid, in parallel
+ *
+ * @return a grid of the results of `f(const T &cell)`, with the same dimensions. `bool` results are stored as
+ * `uint8_t`, see CellResult.
+ */
+template <typename T, typename F, typename R = std::invoke_result_t<F &, const T &>>
+numericGrid<CellResult<R>> parallelTransform(const numericGrid<T> &grid, F &&f, unsigned threads = 0) {
+  numericGrid<CellResult<R>> out{grid.rows(), grid.columns()};
+  parallelRows(
+      grid.rows(), grid.columns(),
+      [&](unsigned, std::size_t first, std::size_t last) {
+        const T *in = grid.data();
+        auto *dst = out.data();
+        for (std::size_t i = first * grid.columns(); i < last * grid.columns(); ++i)
+          dst[i] = f(in[i]);
+      },
+      threads);
+  return out;
+}
+
+/**
+ * @brief map every cell, and combine the results, in parallel
+ *
+ * Each block of rows is reduced on its own, and the block results are folded into `init` in row order. So `reduce`
+ * has to be associative, but not commutative, and the result does not depend on the number of threads.
+ *
+ * @param grid the grid
+ * @param init the initial value
+ * @param reduce `R reduce(R, R)`
+ * @param transform `R transform(const T &cell)`
+ */
+template <typename T, typename R, typename Reduce, typename Transform>
+R parallelTransformReduce(const numericGrid<T> &grid, R init, Reduce &&reduce, Transform &&transform, unsigned threads = 0) {
+  auto const block = rowsPerBlock(grid.columns());
+  std::vector<std::optional<R>> partial((grid.rows() + block - 1) / block);
+  parallelRows(
+      grid.rows(), grid.columns(),
+      [&](unsigned, std::size_t first, std::size_t last) {
+        const T *cells = grid.data();
+        auto const begin = first * grid.columns(), end = last * grid.columns();
+        if (begin == end)
+          return;
+        R acc = transform(cells[begin]);
+        for (std::size_t i = begin + 1; i < end; ++i)
+          acc = reduce(std::move(acc), transform(cells[i]));
+        partial[first / block] = std::move(acc);
+      },
+      threads);
+  for (auto &p : partial)
+    if (p)
+      init = reduce(std::move(init), std::move(*p));
+  return init;
+}
+
+/**
+ * @brief combine all cells, in parallel
+ * @see parallelTransformReduce()
+ */
+template <typename T, typename R, typename Reduce = std::plus<>> R parallelReduce(const numericGrid<T> &grid, R init, Reduce &&reduce = {}, unsigned threads = 0) {
+  return parallelTransformReduce(grid, std::move(init), std::forward<Reduce>(reduce), [](const T &v) { return R(v); }, threads);
+}
+
+/**
+ * @brief count the cells matching a predicate, in parallel
+ */
+template <typename T, typename Pred> std::size_t parallelCountIf(const numericGrid<T> &grid, Pred &&pred, unsigned threads = 0) {
+  return parallelTransformReduce(
+      grid, std::size_t{0}, std::plus<>{}, [&pred](const T &v) { return static_cast<std::size_t>(static_cast<bool>(pred(v))); }, threads);
+}
+
+} // namespace AoC
+
+#endif // PARALLELGRID_H
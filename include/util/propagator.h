@@ -0,0 +1,259 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROPAGATOR_H
+#define PROPAGATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "numericGrid.h"
+#include "stencil.h"
+
+namespace AoC {
+
+/**
+ * @brief the connected components of a grid, see Propagator::label()
+ */
+struct Components {
+  /// label of cells, that are not part of any component
+  static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+  /// the component of every cell, or none
+  numericGrid<uint32_t> labels;
+  /// the number of cells per component, indexed by label
+  std::vector<std::size_t> sizes;
+
+  /** @brief the number of components */
+  [[nodiscard]] std::size_t count() const { return sizes.size(); }
+};
+
+/**
+ * @class Propagator
+ * @brief worklist based propagation over a numericGrid: flood fill, connected components and threshold cascades.
+ *
+ * Instead of scanning the whole grid again for every wave, the cells to process are kept in a queue, and every cell is
+ * processed at most once per call. All operations run in linear time.
+ *
+ * The queue and the visited marks are kept between calls, so one Propagator can be reused for many runs without any
+ * allocation. Visited marks are reset by bumping an epoch counter, not by clearing them.
+ *
+ * Positions are given as pairs of x,y, like for numericGrid. Internally, cells are addressed by their row-major index.
+ */
+class Propagator {
+public:
+  using position = std::pair<std::size_t, std::size_t>;
+
+  Propagator() = default;
+
+  /**
+   * @brief preallocate for grids up to a number of cells
+   */
+  explicit Propagator(std::size_t cells) { prepare(cells); }
+
+  /**
+   * @brief breadth first flood fill from a start cell.
+   *
+   * `pass` decides if a neighbour can be entered. It is either called as `pass(const T &to)`, or as
+   * `pass(const T &from, const T &to)` for rules depending on both cells, like "at most one higher". The start cell is
+   * always entered.
+   *
+   * `visit(position, distance)` is invoked for every reached cell, in order of its distance from the start.
+   *
+   * @return the number of reached cells, including the start
+   * @throws std::invalid_argument if start is not inside the grid
+   */
+  template <typename T, std::size_t N, typename Pass, typename Visit>
+  std::size_t floodFill(const numericGrid<T> &grid, const position &start, const Stencil<N> &stencil, Pass &&pass, Visit &&visit) {
+    if (start.first >= grid.columns() || start.second >= grid.rows())
+      throw std::invalid_argument("Propagator: start is outside of the grid");
+    prepare(grid.size());
+    auto const columns = grid.columns();
+    const T *cells = grid.data();
+    auto const first = start.second * columns + start.first;
+    mark(first);
+    m_queue.push_back(first);
+
+    std::size_t distance = 0, levelEnd = 1;
+    for (std::size_t head = 0; head < m_queue.size(); ++head) {
+      if (head == levelEnd) {
+        ++distance;
+        levelEnd = m_queue.size();
+      }
+      auto const idx = m_queue[head];
+      visit(position{idx % columns, idx / columns}, distance);
+      forEachNeighbour(grid, idx, stencil, [&](std::size_t n) {
+        if (!marked(n) && enters(pass, cells[idx], cells[n])) {
+          mark(n);
+          m_queue.push_back(n);
+        }
+      });
+    }
+    return m_queue.size();
+  }
+
+  /// @overload
+  template <typename T, std::size_t N, typename Pass>
+  std::size_t floodFill(const numericGrid<T> &grid, const position &start, const Stencil<N> &stencil, Pass &&pass) {
+    return floodFill(grid, start, stencil, std::forward<Pass>(pass), [](const position &, std::size_t) {});
+  }
+
+  /**
+   * @brief label the connected components of a grid.
+   *
+   * With `connect(const T &cell)`, all cells matching the predicate are grouped with their matching neighbours, the
+   * other cells are labelled Components::none. With `connect(const T &a, const T &b)`, every cell is part of a
+   * component, and neighbours are grouped if the function returns true (e.g. `std::equal_to` for regions of equal
+   * values).
+   *
+   * Labels are assigned in row-major order of the first cell of each component.
+   */
+  template <typename T, std::size_t N, typename Connect> Components label(const numericGrid<T> &grid, const Stencil<N> &stencil, Connect &&connect) {
+    constexpr bool unary = std::is_invocable_r_v<bool, Connect &, const T &>;
+    prepare(grid.size());
+    Components out{numericGrid<uint32_t>{grid.rows(), grid.columns(), Components::none}, {}};
+    const T *cells = grid.data();
+    uint32_t *labels = out.labels.data();
+
+    for (std::size_t seed = 0; seed < grid.size(); ++seed) {
+      if (marked(seed))
+        continue;
+      if constexpr (unary)
+        if (!connect(cells[seed]))
+          continue;
+
+      auto const id = static_cast<uint32_t>(out.sizes.size());
+      auto const begin = m_queue.size();
+      mark(seed);
+      m_queue.push_back(seed);
+      for (std::size_t head = begin; head < m_queue.size(); ++head) {
+        auto const idx = m_queue[head];
+        labels[idx] = id;
+        forEachNeighbour(grid, idx, stencil, [&](std::size_t n) {
+          if (marked(n))
+            return;
+          bool join;
+          if constexpr (unary)
+            join = connect(cells[n]);
+          else
+            join = connect(cells[idx], cells[n]);
+          if (join) {
+            mark(n);
+            m_queue.push_back(n);
+          }
+        });
+      }
+      out.sizes.push_back(m_queue.size() - begin);
+    }
+    return out;
+  }
+
+  /**
+   * @brief run a threshold cascade, like flashing or toppling cells.
+   *
+   * Every cell for which `fires(const T &)` is true is triggered. A triggered cell calls `spread(T &neighbour)` for each
+   * of its neighbours, which then may fire as well. Each cell triggers at most once per call, the cells that did are
+   * available through triggered() afterwards, e.g. to reset them.
+   *
+   * @return the number of triggered cells
+   */
+  template <typename T, std::size_t N, typename Fires, typename Spread>
+  std::size_t cascade(numericGrid<T> &grid, const Stencil<N> &stencil, Fires &&fires, Spread &&spread) {
+    prepare(grid.size());
+    T *cells = grid.data();
+    for (std::size_t idx = 0; idx < grid.size(); ++idx) {
+      if (fires(std::as_const(cells[idx]))) {
+        mark(idx);
+        m_queue.push_back(idx);
+      }
+    }
+    for (std::size_t head = 0; head < m_queue.size(); ++head) {
+      forEachNeighbour(grid, m_queue[head], stencil, [&](std::size_t n) {
+        spread(cells[n]);
+        if (!marked(n) && fires(std::as_const(cells[n]))) {
+          mark(n);
+          m_queue.push_back(n);
+        }
+      });
+    }
+    return m_queue.size();
+  }
+
+  /**
+   * @brief cascade, where cells fire at `threshold` and increment their neighbours
+   */
+  template <typename T, std::size_t N> std::size_t cascade(numericGrid<T> &grid, const Stencil<N> &stencil, T threshold) {
+    return cascade(
+        grid, stencil, [threshold](const T &v) { return !(v < threshold); }, [](T &v) { ++v; });
+  }
+
+  /**
+   * @brief the row-major indices of the cells processed by the last call, in processing order
+   */
+  [[nodiscard]] std::span<const std::size_t> triggered() const { return m_queue; }
+
+private:
+  /// reset the queue and the visited marks for a grid
+  void prepare(std::size_t cells) {
+    m_queue.clear();
+    m_queue.reserve(cells);
+    if (m_stamp.size() < cells)
+      m_stamp.resize(cells, 0);
+    if (++m_epoch == 0) {
+      std::ranges::fill(m_stamp, 0);
+      m_epoch = 1;
+    }
+  }
+
+  void mark(std::size_t idx) { m_stamp[idx] = m_epoch; }
+  [[nodiscard]] bool marked(std::size_t idx) const { return m_stamp[idx] == m_epoch; }
+
+  template <typename Pass, typename T> static bool enters(Pass &pass, const T &from, const T &to) {
+    if constexpr (std::is_invocable_r_v<bool, Pass &, const T &, const T &>)
+      return pass(from, to);
+    else
+      return pass(to);
+  }
+
+  /// invoke `f(index)` for every neighbour inside the grid
+  template <typename T, std::size_t N, typename F> static void forEachNeighbour(const numericGrid<T> &grid, std::size_t idx, const Stencil<N> &stencil, F &&f) {
+    auto const columns = static_cast<std::ptrdiff_t>(grid.columns()), rows = static_cast<std::ptrdiff_t>(grid.rows());
+    auto const x = static_cast<std::ptrdiff_t>(idx) % columns, y = static_cast<std::ptrdiff_t>(idx) / columns;
+    for (auto [dx, dy] : stencil) {
+      auto const nx = x + dx, ny = y + dy;
+      if (nx >= 0 && ny >= 0 && nx < columns && ny < rows)
+        f(static_cast<std::size_t>(ny * columns + nx));
+    }
+  }
+
+  std::vector<std::size_t> m_queue;
+  std::vector<uint32_t> m_stamp;
+  uint32_t m_epoch{};
+};
+
+} // namespace AoC
+
+#endif // PROPAGATOR_H
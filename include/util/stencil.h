@@ -0,0 +1,62 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STENCIL_H
+#define STENCIL_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace AoC {
+
+/**
+ * @brief relative position of a neighbour, as a pair of x,y
+ */
+using Offset = std::pair<std::ptrdiff_t, std::ptrdiff_t>;
+
+/**
+ * @brief a fixed set of neighbour offsets
+ *
+ * @tparam N number of neighbours
+ */
+template <std::size_t N> using Stencil = std::array<Offset, N>;
+
+/** @brief the 4 direct neighbours (up, left, right, down) */
+inline constexpr Stencil<4> stencil4{{{0, -1}, {-1, 0}, {1, 0}, {0, 1}}};
+
+/** @brief the 8 neighbours, including the diagonals, in row-major order */
+inline constexpr Stencil<8> stencil8{{{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}}};
+
+/**
+ * @brief the largest distance a stencil reaches in any direction
+ */
+template <std::size_t N> constexpr std::size_t stencilReach(const Stencil<N> &stencil) {
+  std::size_t reach = 0;
+  for (auto [dx, dy] : stencil) {
+    reach = std::max<std::size_t>(reach, static_cast<std::size_t>(dx < 0 ? -dx : dx));
+    reach = std::max<std::size_t>(reach, static_cast<std::size_t>(dy < 0 ? -dy : dy));
+  }
+  return reach;
+}
+
+} // namespace AoC
+
+#endif // STENCIL_H
@@ -0,0 +1,141 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <bidirectionalDijkstra.h>
+#include <gridDijkstra.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "sampleGrid.h"
+
+// the same walker, passing its successors to a sink
+struct EmitIdGridNode : IdGridNode {
+  template <typename Emit> void next(Emit &&emit) const {
+    for (auto &[c, n] : IdGridNode::next())
+      emit(c, EmitIdGridNode{n});
+  }
+
+  std::vector<std::pair<uint32_t, EmitIdGridNode>> prev() const {
+    std::vector<std::pair<uint32_t, EmitIdGridNode>> out;
+    for (auto &[c, n] : IdGridNode::prev())
+      out.emplace_back(c, EmitIdGridNode{n});
+    return out;
+  }
+};
+
+// the path runs from start to goal in single steps, and entering each cell costs its value
+template <typename Node>
+void checkPath(const AoC::numericGrid<uint_fast8_t> &grid, const std::vector<Node> &path, const Node &start, const Node &goal, uint32_t cost) {
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path.front().id(), start.id());
+  EXPECT_EQ(path.back().id(), goal.id());
+  uint32_t sum = 0;
+  for (std::size_t i = 1; i < path.size(); ++i) {
+    auto const &a = path[i - 1], &b = path[i];
+    EXPECT_EQ((a.x > b.x ? a.x - b.x : b.x - a.x) + (a.y > b.y ? a.y - b.y : b.y - a.y), 1);
+    sum += grid[std::pair{b.x, b.y}];
+  }
+  EXPECT_EQ(sum, cost);
+}
+
+TEST(bidirectionalDijkstra, matchesOneSided) {
+  auto grid = sampleRiskMap(60);
+  IdGridNode start, goal;
+  start.g = goal.g = &grid;
+  goal.x = goal.y = 59;
+
+  AoC::Dijkstra<IdGridNode, uint32_t, 1000> oneSided(start, 0, AoC::DijkstraMode::EarlyExit);
+  auto const expected = oneSided.solve().first;
+  EXPECT_EQ(expected, (AoC::GridDijkstra(grid, {0, 0}, {59, 59}).solve()));
+
+  AoC::BidirectionalDijkstra<IdGridNode, uint32_t, 1000> d(start, goal);
+  auto [cost, meeting] = d.solve();
+  EXPECT_EQ(cost, expected);
+  EXPECT_TRUE(d.done());
+  EXPECT_LT(d.stats().expanded, oneSided.stats().expanded);
+
+  // the meeting node lies on a cheapest path
+  AoC::GridDijkstra toMeeting(grid, {0, 0}, {meeting.x, meeting.y});
+  AoC::GridDijkstra fromMeeting(grid, {meeting.x, meeting.y}, {59, 59});
+  EXPECT_EQ(toMeeting.solve() + fromMeeting.solve(), expected);
+}
+
+TEST(bidirectionalDijkstra, pointQueries) {
+  auto grid = sampleRiskMap(25);
+  for (uint32_t i = 0; i < 25; i += 3) {
+    IdGridNode start, goal;
+    start.g = goal.g = &grid;
+    start.x = i;
+    start.y = (i * 11) % 25;
+    goal.x = (i * 7) % 25;
+    goal.y = 24 - i;
+
+    AoC::BidirectionalDijkstra<IdGridNode, uint32_t, 100, AoC::BinaryHeapPolicy> d(start, goal);
+    AoC::GridDijkstra ref(grid, {start.x, start.y}, {goal.x, goal.y});
+    EXPECT_EQ(d.solve().first, ref.solve()) << "query " << i;
+  }
+
+  // start and goal are the same state
+  IdGridNode same;
+  same.g = &grid;
+  AoC::BidirectionalDijkstra<IdGridNode, uint32_t, 100> d(same, same);
+  EXPECT_EQ(d.solve().first, 0);
+}
+
+TEST(bidirectionalDijkstra, path) {
+  auto grid = sampleRiskMap(40);
+  IdGridNode start, goal;
+  start.g = goal.g = &grid;
+  goal.x = goal.y = 39;
+
+  AoC::BidirectionalDijkstra<IdGridNode, uint32_t, 1000> d(start, goal);
+  auto [cost, path] = d.solveWithPath();
+  EXPECT_EQ(cost, (AoC::GridDijkstra(grid, {0, 0}, {39, 39}).solve()));
+  checkPath(grid, path, start, goal, cost);
+  // solve() reports the meeting node, it lies on the path
+  EXPECT_TRUE(std::ranges::any_of(path, [&](auto const &n) { return n.id() == d.winner().id(); }));
+
+  AoC::BidirectionalDijkstra<IdGridNode, uint32_t, 1000> untracked(start, goal);
+  EXPECT_EQ(untracked.solve().first, cost);
+  EXPECT_THROW(static_cast<void>(untracked.path()), std::logic_error);
+  EXPECT_THROW(untracked.trackPath(), std::logic_error);
+
+  AoC::BidirectionalDijkstra<IdGridNode, uint32_t, 100> same(start, start);
+  auto [sameCost, samePath] = same.solveWithPath();
+  EXPECT_EQ(sameCost, 0);
+  EXPECT_EQ(samePath.size(), 1);
+}
+
+TEST(bidirectionalDijkstra, emitNext) {
+  static_assert(AoC::HasEmitNext<EmitIdGridNode> && !AoC::HasNext<EmitIdGridNode>);
+
+  auto grid = sampleRiskMap(40);
+  EmitIdGridNode start, goal;
+  start.g = goal.g = &grid;
+  start.y = 5;
+  goal.x = 37;
+  goal.y = 31;
+
+  AoC::BidirectionalDijkstra<EmitIdGridNode, uint32_t, 1000> d(start, goal);
+  auto [cost, path] = d.solveWithPath();
+  EXPECT_EQ(cost, (AoC::GridDijkstra(grid, {0, 5}, {37, 31}).solve()));
+  checkPath(grid, path, start, goal, cost);
+}
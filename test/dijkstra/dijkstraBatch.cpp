@@ -0,0 +1,50 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dijkstraBatch.h>
+#include <gridDijkstra.h>
+#include <gtest/gtest.h>
+
+#include "sampleGrid.h"
+
+TEST(dijkstraBatch, inputOrder) {
+  auto grid = sampleRiskMap(30);
+
+  std::vector<IdGridNode> starts;
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < 29; ++i) {
+    IdGridNode n;
+    n.g = &grid;
+    n.x = i;
+    n.y = (i * 7) % 29;
+    starts.push_back(n);
+    AoC::GridDijkstra ref(grid, {n.x, n.y}, {29, 29});
+    expected.push_back(ref.solve());
+  }
+
+  AoC::DijkstraBatch<AoC::Dijkstra<IdGridNode, uint32_t, 100>> batch(4, AoC::DijkstraMode::EarlyExit);
+  for (int round = 0; round < 2; ++round) {
+    auto results = batch.solve(starts);
+    ASSERT_EQ(results.size(), starts.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      EXPECT_EQ(results[i].first, expected[i]);
+      EXPECT_TRUE(results[i].second.completed());
+    }
+  }
+}
@@ -0,0 +1,68 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gridDijkstra.h>
+#include <gtest/gtest.h>
+
+// AoC 2021, day 15
+static const char *riskMap = "1163751742\n"
+                             "1381373672\n"
+                             "2136511328\n"
+                             "3694931569\n"
+                             "7463417111\n"
+                             "1319128137\n"
+                             "1359912421\n"
+                             "3125421639\n"
+                             "1293138521\n"
+                             "2311944581\n";
+
+TEST(gridDijkstra, dijkstra) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString(riskMap);
+  AoC::GridDijkstra d(grid, {0, 0}, {9, 9});
+  EXPECT_EQ(d.solve(), 40);
+  EXPECT_EQ(d.distance({0, 0}), 0);
+  EXPECT_EQ(d.distance({0, 2}), 3);
+}
+
+TEST(gridDijkstra, astar) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString(riskMap);
+  AoC::GridDijkstra d(grid, {0, 0}, {9, 9}, AoC::GridHeuristic::Manhattan);
+  EXPECT_EQ(d.solve(), 40);
+
+  // the reverse path skips the goal weight, but pays for the start: both are 1
+  AoC::GridDijkstra back(grid, {9, 9}, {0, 0}, AoC::GridHeuristic::Manhattan);
+  EXPECT_EQ(back.solve(), 40);
+}
+
+TEST(gridDijkstra, startIsGoal) {
+  AoC::numericGrid<uint_fast8_t> grid{1, 1, 5};
+  AoC::GridDijkstra<uint_fast8_t, uint16_t> d(grid, {0, 0}, {0, 0});
+  EXPECT_EQ(d.solve(), 0);
+}
+
+TEST(gridDijkstra, emptyGrid) {
+  AoC::numericGrid<uint_fast8_t> grid;
+  EXPECT_THROW((AoC::GridDijkstra<uint_fast8_t, uint16_t>(grid, {0, 0}, {0, 0})), std::invalid_argument);
+}
+
+TEST(gridDijkstra, outsideOfGrid) {
+  AoC::numericGrid<uint_fast8_t> grid{3, 2, 1};
+  EXPECT_THROW((AoC::GridDijkstra<uint_fast8_t, uint16_t>(grid, {2, 0}, {0, 0})), std::invalid_argument);
+  EXPECT_THROW((AoC::GridDijkstra<uint_fast8_t, uint16_t>(grid, {0, 0}, {0, 3})), std::invalid_argument);
+}
@@ -0,0 +1,103 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <countingResource.h>
+#include <gtest/gtest.h>
+#include <nodeStore.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+TEST(nodeStore, handles) {
+  AoC::NodeStore<std::string, 2> store;
+  auto a = store.emplace("a");
+  auto b = store.emplace(3, 'b');
+  EXPECT_EQ(store[a], "a");
+  EXPECT_EQ(store[b], "bbb");
+  EXPECT_EQ(store.size(), 2);
+
+  // freed slots are reused first
+  store.erase(a);
+  auto c = store.emplace("c");
+  EXPECT_EQ(c, a);
+  EXPECT_EQ(store[c], "c");
+
+  // references stay valid, while new slabs are added
+  auto &ref = store[b];
+  for (int i = 0; i < 20; ++i)
+    store.emplace(std::to_string(i));
+  EXPECT_EQ(&ref, &store[b]);
+  EXPECT_EQ(store.size(), 22);
+  EXPECT_GE(store.capacity(), 22);
+}
+
+TEST(nodeStore, destroysLiveObjects) {
+  auto counter = std::make_shared<int>();
+  AoC::CountingResource upstream;
+  {
+    AoC::NodeStore<std::shared_ptr<int>, 3> store{&upstream};
+    std::vector<uint32_t> handles;
+    for (int i = 0; i < 20; ++i)
+      handles.push_back(store.emplace(counter));
+    for (std::size_t i = 0; i < handles.size(); i += 3)
+      store.erase(handles[i]);
+    EXPECT_EQ(counter.use_count(), 1 + 13);
+
+    store.clear();
+    EXPECT_EQ(counter.use_count(), 1);
+    EXPECT_EQ(store.size(), 0);
+
+    store.emplace(counter);
+  }
+  EXPECT_EQ(counter.use_count(), 1);
+  EXPECT_EQ(upstream.current(), 0);
+}
+
+struct Tracked {
+  static inline int alive = 0;
+
+  explicit Tracked(bool fail) {
+    if (fail)
+      throw std::runtime_error("Tracked");
+    ++alive;
+  }
+  Tracked(const Tracked &) = delete;
+  ~Tracked() { --alive; }
+};
+
+TEST(nodeStore, throwingConstructor) {
+  AoC::NodeStore<Tracked, 2> store;
+  auto a = store.emplace(false);
+  // neither a fresh nor a reused slot is lost
+  EXPECT_THROW(store.emplace(true), std::runtime_error);
+  store.erase(a);
+  EXPECT_THROW(store.emplace(true), std::runtime_error);
+  EXPECT_EQ(store.size(), 0);
+
+  auto b = store.emplace(false);
+  auto c = store.emplace(false);
+  EXPECT_EQ(b, a);
+  EXPECT_EQ(c, a + 1);
+  EXPECT_EQ(Tracked::alive, 2);
+
+  // clear() only destroys constructed objects
+  store.clear();
+  EXPECT_EQ(Tracked::alive, 0);
+}
@@ -0,0 +1,92 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dijkstra.h>
+#include <gridDijkstra.h>
+#include <gtest/gtest.h>
+#include <priorityQueue.h>
+
+#include "sampleGraph.h"
+#include "sampleGrid.h"
+
+template <class Policy> class priorityQueue : public ::testing::Test {};
+
+using Policies = ::testing::Types<AoC::BinaryHeapPolicy, AoC::DaryHeapPolicy<4>, AoC::DaryHeapPolicy<8>, AoC::RadixHeapPolicy, AoC::BucketQueuePolicy>;
+TYPED_TEST_SUITE(priorityQueue, Policies);
+
+TYPED_TEST(priorityQueue, monotone) {
+  // Dijkstra like usage: pop the minimum, push a few keys that are not smaller
+  typename TypeParam::template queue<uint32_t, uint32_t> q;
+  q.push(0, 0);
+  uint32_t seed = 7, last = 0, popped = 0;
+  while (!q.empty() && popped < 10000) {
+    auto [k, v] = q.top();
+    q.pop();
+    ASSERT_GE(k, last);
+    last = k;
+    ++popped;
+    for (int i = 0; i < 3; ++i) {
+      seed = seed * 1103515245 + 12345;
+      q.push(k + (seed >> 16) % 100, v + 1);
+    }
+  }
+  EXPECT_EQ(popped, 10000);
+
+  q.clear();
+  EXPECT_TRUE(q.empty());
+  q.push(3, 1);
+  q.push(1, 2);
+  EXPECT_EQ(q.top().second, 2);
+  EXPECT_EQ(q.size(), 2);
+}
+
+TYPED_TEST(priorityQueue, dijkstra) {
+  Graph g;
+  Node start{.g = &g};
+  AoC::Dijkstra<Node, uint32_t, 30, 0, TypeParam> d(start);
+  EXPECT_EQ(d.solve().first, 565);
+
+  auto grid = sampleRiskMap(30);
+  AoC::GridDijkstra<uint_fast8_t> reference(grid, {0, 0}, {29, 29});
+  AoC::GridDijkstra<uint_fast8_t, uint32_t, TypeParam> gd(grid, {0, 0}, {29, 29}, AoC::GridHeuristic::Manhattan);
+  EXPECT_EQ(gd.solve(), reference.solve());
+}
+
+TEST(priorityQueue, notMonotone) {
+  AoC::RadixHeapQueue<uint32_t, int> radix;
+  radix.push(5, 1);
+  radix.pop();
+  EXPECT_THROW(radix.push(4, 2), std::logic_error);
+
+  AoC::BucketQueue<uint32_t, int> bucket;
+  bucket.push(5, 1);
+  bucket.pop();
+  EXPECT_THROW(bucket.push(4, 2), std::logic_error);
+}
+
+TEST(priorityQueue, autoPolicy) {
+  static_assert(std::is_same_v<AoC::AutoQueuePolicy::queue<uint32_t, int>, AoC::RadixHeapQueue<uint32_t, int>>);
+  static_assert(std::is_same_v<AoC::AutoQueuePolicy::queue<double, int>, AoC::BinaryHeapQueue<double, int>>);
+  static_assert(std::is_same_v<AoC::AutoQueuePolicy::queue<int, int>, AoC::BinaryHeapQueue<int, int>>);
+
+  AoC::AutoQueuePolicy::queue<double, int> q;
+  q.push(2.5, 1);
+  q.push(-1.0, 2);
+  EXPECT_EQ(q.top().second, 2);
+}
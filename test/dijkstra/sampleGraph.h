@@ -45,7 +45,6 @@ struct Node {
   Graph *g;
 
   std::string last{"Mannheim"};
-  std::vector<std::string> route;
   uint32_t costs{0};
 
   std::vector<std::pair<uint32_t, Node>> next() const {
@@ -57,7 +56,6 @@ struct Node {
       Node node(*this);
       node.last = n.first;
       node.costs += n.second;
-      node.route.push_back(last);
       auto const c = node.costs;
       out.emplace_back(c, std::move(node));
     }
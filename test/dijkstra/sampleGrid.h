@@ -0,0 +1,119 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SAMPLEGRID_H
+#define SAMPLEGRID_H
+
+#include <numericGrid.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// generated risk map, with many paths leading into the same cell
+inline AoC::numericGrid<uint_fast8_t> sampleRiskMap(std::size_t side) {
+  AoC::numericGrid<uint_fast8_t> grid{side, side};
+  uint32_t seed = 42;
+  for (auto &v : grid) {
+    seed = seed * 1103515245 + 12345;
+    v = static_cast<uint_fast8_t>(1 + (seed >> 16) % 9);
+  }
+  return grid;
+}
+
+// walks a risk map, moving to a cell costs its value
+struct GridNode {
+  const AoC::numericGrid<uint_fast8_t> *g{};
+  uint32_t x{}, y{}, costs{};
+
+  std::vector<std::pair<uint32_t, GridNode>> next() const {
+    std::vector<std::pair<uint32_t, GridNode>> out;
+    auto move = [&](uint32_t nx, uint32_t ny) {
+      GridNode n{g, nx, ny, costs + g->operator[](std::pair{nx, ny})};
+      out.emplace_back(n.costs, n);
+    };
+    if (x > 0)
+      move(x - 1, y);
+    if (y > 0)
+      move(x, y - 1);
+    if (x + 1 < g->columns())
+      move(x + 1, y);
+    if (y + 1 < g->rows())
+      move(x, y + 1);
+    return out;
+  }
+
+  bool completed() const { return x + 1 == g->columns() && y + 1 == g->rows(); }
+};
+
+// the same walker, with a state identity
+struct IdGridNode : GridNode {
+  std::vector<std::pair<uint32_t, IdGridNode>> next() const {
+    std::vector<std::pair<uint32_t, IdGridNode>> out;
+    for (auto &[c, n] : GridNode::next())
+      out.emplace_back(c, IdGridNode{n});
+    return out;
+  }
+
+  // the reverse moves: leaving a neighbour into this cell costs the value of this cell
+  std::vector<std::pair<uint32_t, IdGridNode>> prev() const {
+    std::vector<std::pair<uint32_t, IdGridNode>> out;
+    auto const c = costs + g->operator[](std::pair{x, y});
+    auto move = [&](uint32_t nx, uint32_t ny) { out.emplace_back(c, IdGridNode{GridNode{g, nx, ny, c}}); };
+    if (x > 0)
+      move(x - 1, y);
+    if (y > 0)
+      move(x, y - 1);
+    if (x + 1 < g->columns())
+      move(x + 1, y);
+    if (y + 1 < g->rows())
+      move(x, y + 1);
+    return out;
+  }
+
+  uint32_t id() const { return y * static_cast<uint32_t>(g->columns()) + x; }
+};
+
+// the same walker, passing its successors to a sink instead of returning them
+struct EmitGridNode {
+  const AoC::numericGrid<uint_fast8_t> *g{};
+  uint32_t x{}, y{}, costs{};
+
+  template <typename Emit> void next(Emit &&emit) const {
+    auto move = [&](uint32_t nx, uint32_t ny) {
+      auto const c = costs + g->operator[](std::pair{nx, ny});
+      // constructed in place by the solver
+      emit(c, g, nx, ny, c);
+    };
+    if (x > 0)
+      move(x - 1, y);
+    if (y > 0)
+      move(x, y - 1);
+    if (x + 1 < g->columns())
+      move(x + 1, y);
+    if (y + 1 < g->rows())
+      move(x, y + 1);
+  }
+
+  bool completed() const { return x + 1 == g->columns() && y + 1 == g->rows(); }
+
+  uint32_t id() const { return y * static_cast<uint32_t>(g->columns()) + x; }
+};
+
+#endif // SAMPLEGRID_H
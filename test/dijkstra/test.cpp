@@ -19,8 +19,10 @@
 
 #include <gtest/gtest.h>
 #include <dijkstra.h>
+#include <gridDijkstra.h>
 
 #include "sampleGraph.h"
+#include "sampleGrid.h"
 
 TEST(dijkstra, sample) {
   // create our graph
@@ -34,4 +36,193 @@ TEST(dijkstra, sample) {
   auto [cost, winner] = d.solve();
   EXPECT_EQ(winner.last,"Bremen");
   EXPECT_EQ(cost, 565);
-}
\ No newline at end of file
+}
+
+TEST(dijkstra, path) {
+  Graph g;
+  Node start{.g = &g};
+  AoC::Dijkstra<Node, uint32_t, 30> d(start);
+
+  auto [cost, path] = d.solveWithPath();
+  EXPECT_EQ(cost, 565);
+  std::vector<std::string> cities;
+  for (auto const &n : path)
+    cities.push_back(n.last);
+  EXPECT_EQ(cities, (std::vector<std::string>{"Mannheim", "Essen", "Bremen"}));
+
+  // the costs along the path never decrease, and every step is an edge of the graph
+  auto grid = sampleRiskMap(30);
+  IdGridNode gridStart;
+  gridStart.g = &grid;
+  AoC::Dijkstra<IdGridNode, uint32_t, 1000> gd(gridStart, 0, AoC::DijkstraMode::EarlyExit);
+  auto [gridCost, gridPath] = gd.solveWithPath();
+  ASSERT_FALSE(gridPath.empty());
+  EXPECT_EQ(gridPath.back().costs, gridCost);
+  for (std::size_t i = 1; i < gridPath.size(); ++i) {
+    auto const &a = gridPath[i - 1], &b = gridPath[i];
+    EXPECT_EQ((a.x > b.x ? a.x - b.x : b.x - a.x) + (a.y > b.y ? a.y - b.y : b.y - a.y), 1);
+    EXPECT_EQ(b.costs, (a.costs + grid[std::pair{b.x, b.y}]));
+  }
+}
+
+TEST(dijkstra, trackPath) {
+  Graph g;
+  Node start{.g = &g};
+
+  // without tracking, no trail is kept
+  AoC::Dijkstra<Node, uint32_t, 30> d(start);
+  EXPECT_EQ(d.solve().first, 565);
+  EXPECT_THROW(static_cast<void>(d.path()), std::logic_error);
+  EXPECT_THROW(d.trackPath(), std::logic_error);
+  EXPECT_THROW(d.solveWithPath(), std::logic_error);
+
+  // it can be enabled again after a reset, and is kept by later resets
+  d.reset(start);
+  d.trackPath();
+  EXPECT_EQ(d.solve().first, 565);
+  EXPECT_EQ(d.path().size(), 3);
+  d.reset(start);
+  EXPECT_EQ(d.solveWithPath().second.size(), 3);
+}
+
+TEST(dijkstra, emitNext) {
+  static_assert(AoC::HasEmitNext<EmitGridNode> && !AoC::HasNext<EmitGridNode>);
+  static_assert(!AoC::HasEmitNext<IdGridNode>);
+
+  auto grid = sampleRiskMap(40);
+  IdGridNode start;
+  start.g = &grid;
+  AoC::Dijkstra<IdGridNode, uint32_t, 1000> ranged(start);
+  auto const expected = ranged.solve().first;
+
+  EmitGridNode emitStart{.g = &grid};
+  AoC::Dijkstra<EmitGridNode, uint32_t, 1000> d(emitStart);
+  auto [cost, path] = d.solveWithPath();
+  EXPECT_EQ(cost, expected);
+  EXPECT_TRUE(path.back().completed());
+  EXPECT_EQ(d.stats().expanded, ranged.stats().expanded);
+  EXPECT_EQ(d.stats().pushed, ranged.stats().pushed);
+}
+
+// a line of nodes, that counts how often it is moved
+struct CountingNode {
+  static inline std::size_t moves = 0;
+
+  CountingNode() = default;
+  explicit CountingNode(uint32_t p) : pos{p} {}
+  CountingNode(const CountingNode &) = default;
+  CountingNode(CountingNode &&o) noexcept : pos{o.pos} { ++moves; }
+  CountingNode &operator=(const CountingNode &) = default;
+  CountingNode &operator=(CountingNode &&o) noexcept {
+    pos = o.pos;
+    ++moves;
+    return *this;
+  }
+
+  [[nodiscard]] bool completed() const { return pos == 1000; }
+  template <typename Emit> void next(Emit &&emit) const { emit(pos + 1, pos + 1); }
+
+  uint32_t pos{};
+};
+
+TEST(dijkstra, emplaceInPlace) {
+  AoC::Dijkstra<CountingNode, uint32_t, 100> d(CountingNode{0});
+  CountingNode::moves = 0;
+  EXPECT_EQ(d.solve().first, 1000);
+  // the emitted nodes are built in their slots, only the winner is swapped out
+  EXPECT_LE(CountingNode::moves, 3);
+}
+
+TEST(dijkstra, identityPruning) {
+  auto grid = sampleRiskMap(40);
+  AoC::GridDijkstra<uint_fast8_t> reference(grid, {0, 0}, {39, 39});
+  auto const expected = reference.solve();
+
+  IdGridNode start;
+  start.g = &grid;
+  AoC::Dijkstra<IdGridNode, uint32_t, 1000> d(start);
+  auto [cost, winner] = d.solve();
+  EXPECT_EQ(cost, expected);
+  EXPECT_TRUE(winner.completed());
+}
+
+TEST(dijkstra, earlyExit) {
+  auto grid = sampleRiskMap(40);
+  IdGridNode start;
+  start.g = &grid;
+
+  AoC::Dijkstra<IdGridNode, uint32_t, 1000> full(start);
+  std::size_t fullSteps = 0;
+  auto [fullCost, fullWinner] = full.solveUntil([&fullSteps](const auto &) {
+    ++fullSteps;
+    return false;
+  });
+
+  AoC::Dijkstra<IdGridNode, uint32_t, 1000> early(start, 0, AoC::DijkstraMode::EarlyExit);
+  std::size_t earlySteps = 0;
+  auto [earlyCost, earlyWinner] = early.solveUntil([&earlySteps](const auto &) {
+    ++earlySteps;
+    return false;
+  });
+
+  EXPECT_EQ(earlyCost, fullCost);
+  EXPECT_TRUE(early.done());
+  EXPECT_LT(earlySteps, fullSteps);
+}
+
+TEST(dijkstra, resumable) {
+  Graph g;
+  Node start{.g = &g};
+  AoC::Dijkstra<Node, uint32_t, 30> d(start);
+
+  // stop after a budget of two steps, and continue afterwards
+  int budget = 2;
+  d.solveUntil([&budget](const auto &) { return --budget == 0; });
+  EXPECT_FALSE(d.done());
+  auto [cost, winner] = d.solve();
+  EXPECT_EQ(cost, 565);
+  EXPECT_TRUE(d.done());
+
+  // start over, reusing the container
+  d.reset(start);
+  EXPECT_EQ(d.solve().first, 565);
+}
+
+TEST(dijkstra, stream) {
+  Graph g;
+  Node start{.g = &g};
+  AoC::Dijkstra<Node, uint32_t, 30> d(start, 0, AoC::DijkstraMode::Stream);
+
+  std::vector<uint32_t> costs;
+  while (costs.size() < 3) {
+    auto res = d.nextResult();
+    ASSERT_TRUE(res);
+    EXPECT_EQ(res->second.last, "Bremen");
+    costs.push_back(res->first);
+  }
+  EXPECT_EQ(costs.front(), 565);
+  EXPECT_TRUE(std::ranges::is_sorted(costs));
+  EXPECT_EQ(d.lowest(), 565);
+}
+
+TEST(dijkstra, upstreamAndStats) {
+  auto grid = sampleRiskMap(40);
+  IdGridNode start;
+  start.g = &grid;
+
+  // a tiny complexity estimate has to grow, instead of failing
+  AoC::CountingResource upstream;
+  {
+    AoC::Dijkstra<IdGridNode, uint32_t, 1> d(start, 0, AoC::DijkstraMode::EarlyExit, &upstream);
+    auto [cost, winner] = d.solve();
+    EXPECT_TRUE(winner.completed());
+
+    auto const stats = d.stats();
+    EXPECT_GT(stats.peakQueue, 1);
+    EXPECT_GE(stats.pushed, stats.expanded);
+    EXPECT_GT(stats.expanded, 0);
+    EXPECT_GT(stats.peakUpstream, 0);
+    EXPECT_EQ(upstream.peak(), stats.peakUpstream);
+  }
+  EXPECT_EQ(upstream.current(), 0);
+}
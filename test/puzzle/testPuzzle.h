@@ -19,7 +19,10 @@
 
 #ifndef TESTPUZZLE_H
 #define TESTPUZZLE_H
+#include <condition_variable>
 #include <istream>
+#include <mutex>
+#include <string_view>
 
 // simple test puzzle structure, used for the puzzle macro test
 struct TestPuzzle {
@@ -28,4 +31,32 @@ struct TestPuzzle {
   int Part2() { return 2; }
 };
 
+// test puzzle that takes the mapped input directly
+struct TestViewPuzzle {
+  TestViewPuzzle(std::string_view input) : size{input.size()} {};
+  std::size_t Part1() { return size > 0; }
+  std::size_t Part2() { return 2; }
+
+  std::size_t size;
+};
+
+// test puzzle with const parts, both parts wait for each other, so they only finish if they run at the same time
+struct TestParallelPuzzle {
+  TestParallelPuzzle(std::istream &){};
+  int Part1() const { return meet(1); }
+  int Part2() const { return meet(2); }
+
+  int meet(int part) const {
+    std::unique_lock lock{m_lock};
+    ++m_arrived;
+    m_cv.notify_all();
+    m_cv.wait(lock, [this] { return m_arrived == 2; });
+    return part;
+  }
+
+  mutable std::mutex m_lock;
+  mutable std::condition_variable m_cv;
+  mutable int m_arrived{};
+};
+
 #endif // TESTPUZZLE_H
@@ -0,0 +1,105 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "automaton.h"
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+namespace {
+uint_fast8_t life(uint_fast8_t cell, const std::array<uint_fast8_t, 8> &n) {
+  auto const alive = std::accumulate(n.begin(), n.end(), 0);
+  return alive == 3 || (cell && alive == 2);
+}
+
+uint_fast8_t spread(uint_fast8_t cell, const std::array<uint_fast8_t, 4> &n) { return std::max(cell, *std::ranges::max_element(n)); }
+
+AoC::numericGrid<uint_fast8_t> randomGrid(std::size_t side) {
+  AoC::numericGrid<uint_fast8_t> grid{side, side};
+  uint32_t state = 1;
+  for (auto &v : grid) {
+    state = state * 1664525u + 1013904223u;
+    v = (state >> 28) < 5;
+  }
+  return grid;
+}
+} // namespace
+
+TEST(automaton, blinker) {
+  auto const start = AoC::numericGrid<uint_fast8_t>::fromString("00000\n"
+                                                                "00100\n"
+                                                                "00100\n"
+                                                                "00100\n"
+                                                                "00000\n");
+  AoC::Automaton<uint_fast8_t> automaton{start};
+  EXPECT_EQ(automaton.step(AoC::stencil8, life), 4);
+  EXPECT_EQ(automaton.grid(), AoC::numericGrid<uint_fast8_t>::fromString("00000\n"
+                                                                         "00000\n"
+                                                                         "01110\n"
+                                                                         "00000\n"
+                                                                         "00000\n"));
+  EXPECT_EQ(automaton.step(AoC::stencil8, life), 4);
+  EXPECT_EQ(automaton.grid(), start);
+  EXPECT_EQ(automaton.generation(), 2);
+  EXPECT_EQ((automaton[{2, 1}]), 1);
+}
+
+TEST(automaton, fixedPoint) {
+  auto grid = AoC::numericGrid<uint_fast8_t>{5, 7};
+  grid[std::pair{0, 0}] = 9;
+  AoC::Automaton<uint_fast8_t> automaton{grid};
+  // the corner needs 4 + 6 steps to reach the opposite one, and one more to notice nothing changes
+  EXPECT_EQ(automaton.run(AoC::stencil4, spread), 11);
+  EXPECT_EQ(automaton.grid().count(9), 35);
+
+  AoC::Automaton<uint_fast8_t> limited{grid};
+  EXPECT_EQ(limited.run(AoC::stencil4, spread, 3), 3);
+  EXPECT_EQ(limited.grid().count(9), 1 + 2 + 3 + 4);
+
+  EXPECT_THROW(limited.step(AoC::Stencil<1>{{{2, 0}}}, [](auto c, auto) { return c; }), std::invalid_argument);
+}
+
+TEST(automaton, activeSet) {
+  auto const start = randomGrid(40);
+  AoC::Automaton<uint_fast8_t> full{start}, active{start};
+  active.enableActiveSet();
+  for (int i = 0; i < 50; ++i)
+    ASSERT_EQ(full.step(AoC::stencil8, life), active.step(AoC::stencil8, life)) << i;
+  EXPECT_EQ(full.grid(), active.grid());
+}
+
+TEST(automaton, threads) {
+  // large enough to be split into blocks of rows
+  auto const start = randomGrid(300);
+  // shared is stepped on sharedPool()
+  AoC::Automaton<uint_fast8_t> serial{start}, parallel{start}, active{start}, shared{start};
+  serial.setThreads(1);
+  parallel.setThreads(4);
+  active.setThreads(4);
+  active.enableActiveSet();
+  for (int i = 0; i < 10; ++i) {
+    auto const changed = serial.step(AoC::stencil8, life);
+    EXPECT_EQ(parallel.step(AoC::stencil8, life), changed);
+    EXPECT_EQ(active.step(AoC::stencil8, life), changed);
+    EXPECT_EQ(shared.step(AoC::stencil8, life), changed);
+  }
+  EXPECT_EQ(serial.grid(), parallel.grid());
+  EXPECT_EQ(serial.grid(), active.grid());
+  EXPECT_EQ(serial.grid(), shared.grid());
+}
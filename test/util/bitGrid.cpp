@@ -0,0 +1,100 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bitGrid.h"
+#include <gtest/gtest.h>
+
+TEST(bitGrid, access) {
+  AoC::bitGrid grid{3, 100};
+  EXPECT_EQ(grid.stride(), 2);
+  EXPECT_TRUE(grid.none());
+
+  grid[{99, 2}] = true;
+  grid.set(64, 1);
+  grid[{0, 0}].flip();
+  EXPECT_TRUE((grid[{99, 2}]));
+  EXPECT_TRUE(grid.test(64, 1));
+  EXPECT_FALSE(grid.test(63, 1));
+  EXPECT_EQ(grid.count(), 3);
+
+  std::vector<std::pair<std::size_t, std::size_t>> set;
+  grid.forEachSet([&set](auto x, auto y) { set.emplace_back(x, y); });
+  EXPECT_EQ(set, (std::vector<std::pair<std::size_t, std::size_t>>{{0, 0}, {64, 1}, {99, 2}}));
+
+  // the unused bits at the end of a row stay clear
+  AoC::bitGrid full{3, 100, true};
+  EXPECT_EQ(full.count(), 300);
+  EXPECT_EQ(~grid, full ^ grid);
+  EXPECT_EQ(grid.flip().count(), 300 - 3);
+}
+
+TEST(bitGrid, logic) {
+  auto a = AoC::bitGrid::fromString("##..\n"
+                                    "#.#.\n");
+  auto b = AoC::bitGrid::fromString("#.#.\n"
+                                    "....\n");
+  EXPECT_EQ((a & b).count(), 1);
+  EXPECT_EQ((a | b).count(), 5);
+  EXPECT_EQ((a ^ b).count(), 4);
+  EXPECT_EQ(AoC::bitGrid{a}.andNot(b).count(), 3);
+  EXPECT_THROW(a &= AoC::bitGrid(2, 5), std::invalid_argument);
+
+  auto digits = AoC::numericGrid<uint_fast8_t>::fromString("1900\n1090\n");
+  EXPECT_EQ(AoC::bitGrid(digits, [](auto v) { return v >= 1; }), a);
+}
+
+TEST(bitGrid, shift) {
+  AoC::bitGrid grid{3, 130};
+  grid.set(0, 0);
+  grid.set(63, 1);
+  grid.set(129, 2);
+
+  auto moved = grid.shifted(1, 0);
+  EXPECT_EQ(moved.count(), 2);
+  EXPECT_TRUE(moved.test(1, 0));
+  EXPECT_TRUE(moved.test(64, 1));
+
+  moved = grid.shifted(-66, 0);
+  EXPECT_EQ(moved.count(), 1);
+  EXPECT_TRUE(moved.test(63, 2));
+
+  moved = grid.shifted(70, 1);
+  EXPECT_EQ(moved.count(), 1);
+  EXPECT_TRUE(moved.test(70, 1));
+
+  moved = grid.shifted(0, -1);
+  EXPECT_EQ(moved.count(), 2);
+  EXPECT_TRUE(moved.test(63, 0));
+  EXPECT_TRUE(moved.test(129, 1));
+}
+
+TEST(bitGrid, neighbours) {
+  AoC::bitGrid grid{3, 70};
+  grid.set(64, 1);
+
+  auto n = grid.neighbours(AoC::stencil8);
+  EXPECT_EQ(n.count(), 8);
+  EXPECT_FALSE(n.test(64, 1));
+  EXPECT_TRUE(n.test(63, 0));
+  EXPECT_TRUE(n.test(65, 2));
+
+  n = grid.neighbours(AoC::stencil4);
+  EXPECT_EQ(n, AoC::bitGrid::fromString(std::string(64, '.') + "#.....\n" + std::string(63, '.') + "#.#....\n" +
+                                        std::string(64, '.') + "#.....\n"));
+}
@@ -0,0 +1,71 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// built with AOC_NO_MMAP, to cover the fallback for systems without POSIX memory mapping
+
+#include "inputSource.h"
+#include "numericGrid.h"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+TEST(fallback, mappedFile) {
+  auto const filename = std::filesystem::temp_directory_path() / "fallback-mapped.txt";
+  {
+    std::ofstream out{filename};
+    out << "123\n456\n";
+  }
+  {
+    AoC::MappedFile file{filename};
+    EXPECT_EQ(file.view(), "123\n456\n");
+    EXPECT_EQ(file.size(), 8);
+
+    auto grid = AoC::numericGrid<uint_fast8_t>::fromFile(filename);
+    EXPECT_EQ(grid.rows(), 2);
+    EXPECT_EQ((grid[std::pair{2, 1}]), 6);
+  }
+  std::filesystem::remove(filename);
+
+  EXPECT_THROW(AoC::MappedFile{"/nonexistent/input.txt"}, std::system_error);
+}
+
+TEST(fallback, inputSource) {
+  auto const filename = std::filesystem::temp_directory_path() / "fallback-input.txt";
+  {
+    std::ofstream out{filename};
+    out << "111\n222\n";
+  }
+  {
+    AoC::InputSource input{filename};
+    EXPECT_TRUE(input.mapped());
+    EXPECT_EQ(input.view(), "111\n222\n");
+  }
+  {
+    AoC::InputSource input{filename};
+    std::string line;
+    std::getline(input.stream(), line);
+    EXPECT_EQ(line, "111");
+  }
+  std::filesystem::remove(filename);
+
+  EXPECT_THROW(AoC::InputSource{"/nonexistent/input.txt"}, std::system_error);
+}
@@ -0,0 +1,81 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "fixedGrid.h"
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <sstream>
+
+using Grid3 = AoC::fixedGrid<uint_fast8_t, 3, 3>;
+
+constexpr int constexprNeighbourSum() {
+  Grid3 grid;
+  for (std::size_t i = 0; i < grid.size(); ++i)
+    grid.data()[i] = static_cast<uint_fast8_t>(i + 1);
+  int sum = 0;
+  grid.forEachNeighbour({0, 0}, AoC::stencil8, [&sum](auto v) { sum += v; });
+  return sum;
+}
+
+TEST(fixedGrid, constexprAccess) {
+  static_assert(Grid3::size() == 9);
+  static_assert(Grid3::index(2, 1) == 5);
+  static_assert(!Grid3::contains(3, 0) && !Grid3::contains(0, -1));
+  static_assert(Grid3::offsets(AoC::stencil4) == std::array<std::ptrdiff_t, 4>{-3, -1, 1, 3});
+  static_assert(constexprNeighbourSum() == 2 + 4 + 5);
+}
+
+TEST(fixedGrid, stream) {
+  std::istringstream in{"123\n456\n789\n"};
+  Grid3 grid;
+  in >> grid;
+  ASSERT_FALSE(in.fail());
+  EXPECT_EQ((grid[std::pair{0, 0}]), 1);
+  EXPECT_EQ((grid[std::pair{2, 1}]), 6);
+  EXPECT_EQ(grid[2][1], 8);
+  EXPECT_EQ(std::accumulate(grid.begin(), grid.end(), 0), 45);
+  EXPECT_EQ(grid, Grid3::fromString("123\r\n456\r\n789"));
+  EXPECT_EQ(grid, Grid3{grid.toGrid()});
+
+  std::istringstream shortRow{"123\n45\n789\n"};
+  Grid3 bad;
+  shortRow >> bad;
+  EXPECT_TRUE(shortRow.fail());
+
+  std::istringstream missing{"123\n456\n"};
+  missing >> bad;
+  EXPECT_TRUE(missing.fail());
+
+  EXPECT_THROW(Grid3::fromString("123\n456\n789\n123\n"), std::invalid_argument);
+  EXPECT_THROW((AoC::fixedGrid<uint_fast8_t, 2, 2>{grid.toGrid()}), std::invalid_argument);
+}
+
+TEST(fixedGrid, apply) {
+  auto grid = AoC::fixedGrid<uint_fast8_t, 3, 3>::fromString("010\n"
+                                                             "111\n"
+                                                             "010\n");
+  auto lit = grid.apply(AoC::stencil8, [](auto, const auto &n) { return std::accumulate(n.begin(), n.end(), 0); });
+  static_assert(std::is_same_v<decltype(lit), AoC::fixedGrid<int, 3, 3>>);
+  EXPECT_EQ((lit[std::pair{1, 1}]), 4);
+  EXPECT_EQ((lit[std::pair{0, 0}]), 3);
+  EXPECT_EQ((lit[std::pair{1, 0}]), 3);
+  EXPECT_EQ(lit.count(3), 8);
+  EXPECT_EQ(grid.countIf([](auto v) { return v == 1; }), 5);
+}
@@ -0,0 +1,140 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gridKernels.h"
+#include "numericGrid.h"
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<const AoC::kernels::KernelTable *> availableTables() {
+  std::vector<const AoC::kernels::KernelTable *> tables{&AoC::kernels::scalar::table};
+#ifdef AOC_KERNELS_X86
+  tables.push_back(&AoC::kernels::sse2::table);
+  if (__builtin_cpu_supports("avx2"))
+    tables.push_back(&AoC::kernels::avx2::table);
+#endif
+  return tables;
+}
+
+// odd length, so every kernel has to handle a tail
+std::vector<std::uint8_t> sample() {
+  std::vector<std::uint8_t> data(101);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<std::uint8_t>((i * 37) % 251);
+  return data;
+}
+
+} // namespace
+
+TEST(gridKernels, matchScalar) {
+  auto const ref = sample();
+  for (auto table : availableTables()) {
+    SCOPED_TRACE(static_cast<int>(table->isa));
+
+    auto data = ref;
+    table->add(data.data(), data.size(), 200);
+    for (std::size_t i = 0; i < data.size(); ++i)
+      EXPECT_EQ(data[i], static_cast<std::uint8_t>(ref[i] + 200));
+
+    data = ref;
+    table->subSaturate(data.data(), data.size(), 100);
+    for (std::size_t i = 0; i < data.size(); ++i)
+      EXPECT_EQ(data[i], ref[i] < 100 ? 0 : ref[i] - 100);
+
+    data = ref;
+    table->addSaturate(data.data(), data.size(), 100);
+    for (std::size_t i = 0; i < data.size(); ++i)
+      EXPECT_EQ(data[i], ref[i] > 155 ? 255 : ref[i] + 100);
+
+    data = ref;
+    table->clamp(data.data(), data.size(), 10, 20);
+    for (std::size_t i = 0; i < data.size(); ++i)
+      EXPECT_EQ(data[i], std::clamp<std::uint8_t>(ref[i], 10, 20));
+
+    EXPECT_EQ(table->countAtLeast(ref.data(), ref.size(), 128), AoC::kernels::scalar::countAtLeast(ref.data(), ref.size(), 128));
+    EXPECT_EQ(table->countEqual(ref.data(), ref.size(), ref[99]), AoC::kernels::scalar::countEqual(ref.data(), ref.size(), ref[99]));
+    EXPECT_EQ(table->findAtLeast(ref.data(), ref.size(), 250), AoC::kernels::scalar::findAtLeast(ref.data(), ref.size(), 250));
+    EXPECT_EQ(table->findAtLeast(ref.data(), ref.size(), 255), ref.size());
+
+    std::string digits(77, '7');
+    digits[70] = '3';
+    std::vector<std::uint8_t> decoded(digits.size());
+    table->decodeDigits(digits.data(), decoded.data(), digits.size());
+    EXPECT_EQ(decoded[0], 7);
+    EXPECT_EQ(decoded[70], 3);
+  }
+}
+
+static_assert(AoC::kernels::isByteCell<uint8_t>);
+static_assert(!AoC::kernels::isByteCell<bool>);
+static_assert(!AoC::kernels::isByteCell<int8_t>);
+
+TEST(gridKernels, gridOperations) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString("1234\n5678\n9012\n");
+  grid.add(1);
+  EXPECT_EQ(grid[0][0], 2);
+  EXPECT_EQ(grid.countAtLeast(10), 1);
+  EXPECT_EQ(*grid.findAtLeast(10), 10);
+  grid.clamp(0, 9);
+  EXPECT_EQ(grid.count(9), 2);
+  grid.subSaturate(5);
+  EXPECT_EQ(grid.count(0), 7);
+  EXPECT_EQ(grid.countIf([](auto v) { return v > 2; }), 3);
+  EXPECT_EQ(grid.findIf([](auto v) { return v > 100; }), grid.end());
+
+  // searching works on const grids as well
+  auto const &cgrid = grid;
+  EXPECT_EQ(*cgrid.findAtLeast(4), 4);
+  EXPECT_EQ(cgrid.findAtLeast(10), cgrid.end());
+  EXPECT_EQ(*cgrid.findIf([](auto v) { return v > 3; }), 4);
+  static_assert(std::is_same_v<decltype(cgrid.findIf([](auto) { return true; })), AoC::numericGrid<uint_fast8_t>::Iterator<const uint_fast8_t>>);
+
+  // wider cells take the scalar path
+  auto wide = AoC::numericGrid<uint32_t>::fromString("19\n91\n");
+  wide.addSaturate(std::numeric_limits<uint32_t>::max());
+  EXPECT_EQ(wide.count(std::numeric_limits<uint32_t>::max()), 4);
+
+  // signed cells saturate at both ends, for negative arguments as well
+  constexpr auto lowest = std::numeric_limits<int>::lowest(), highest = std::numeric_limits<int>::max();
+  auto sgn = AoC::numericGrid<int>::fromString("19\n91\n");
+  sgn.addSaturate(-5);
+  EXPECT_EQ(sgn[0][0], -4);
+  EXPECT_EQ(sgn[0][1], 4);
+  sgn.addSaturate(lowest);
+  EXPECT_EQ(sgn[0][0], lowest);
+  EXPECT_EQ(sgn[0][1], lowest + 4);
+  sgn.addSaturate(-5);
+  EXPECT_EQ(sgn.count(lowest), 4);
+  sgn.subSaturate(-3);
+  EXPECT_EQ(sgn.count(lowest + 3), 4);
+  sgn.subSaturate(lowest);
+  EXPECT_EQ(sgn.count(3), 4);
+  sgn.subSaturate(lowest);
+  EXPECT_EQ(sgn.count(highest), 4);
+  sgn.subSaturate(highest);
+  EXPECT_EQ(sgn.count(0), 4);
+  sgn.subSaturate(highest);
+  sgn.subSaturate(highest);
+  EXPECT_EQ(sgn.count(lowest), 4);
+}
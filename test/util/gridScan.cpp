@@ -0,0 +1,78 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gridScan.h"
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+TEST(gridScan, transposed) {
+  // not a multiple of the tile size in either direction
+  AoC::numericGrid<uint_fast8_t> bytes{70, 130};
+  std::iota(bytes.begin(), bytes.end(), uint_fast8_t{0});
+  auto t = bytes.transposed();
+  ASSERT_EQ(t.rows(), 130);
+  ASSERT_EQ(t.columns(), 70);
+  for (std::size_t y = 0; y < bytes.rows(); ++y)
+    for (std::size_t x = 0; x < bytes.columns(); ++x)
+      ASSERT_EQ((t[std::pair{y, x}]), (bytes[std::pair{x, y}]));
+  EXPECT_EQ(t.transposed(), bytes);
+
+  AoC::numericGrid<uint32_t> wide{3, 41};
+  std::iota(wide.begin(), wide.end(), 0u);
+  auto const columns = wide.transposed();
+  auto column = columns[40];
+  EXPECT_EQ(std::vector<uint32_t>(column.begin(), column.end()), (std::vector<uint32_t>{40, 81, 122}));
+}
+
+TEST(gridScan, visibility) {
+  auto const trees = AoC::numericGrid<uint_fast8_t>::fromString("30373\n"
+                                                                "25512\n"
+                                                                "65332\n"
+                                                                "33549\n"
+                                                                "35390\n");
+  auto const highest = AoC::scanDirections(trees, -1, [](int acc, auto h) { return std::max<int>(acc, h); });
+  EXPECT_EQ((highest.fromLeft[std::pair{2, 1}]), 5);
+  EXPECT_EQ((highest.fromRight[std::pair{2, 1}]), 2);
+  EXPECT_EQ((highest.fromTop[std::pair{2, 1}]), 3);
+  EXPECT_EQ((highest.fromBottom[std::pair{2, 1}]), 5);
+  EXPECT_EQ((highest.fromTop[std::pair{4, 0}]), -1);
+  EXPECT_EQ((highest.fromBottom[std::pair{0, 4}]), -1);
+
+  std::size_t visible = 0;
+  for (std::size_t y = 0; y < trees.rows(); ++y)
+    for (std::size_t x = 0; x < trees.columns(); ++x) {
+      int const h = trees[std::pair{x, y}];
+      visible += h > highest.fromLeft[std::pair{x, y}] || h > highest.fromRight[std::pair{x, y}] || h > highest.fromTop[std::pair{x, y}] ||
+                 h > highest.fromBottom[std::pair{x, y}];
+    }
+  EXPECT_EQ(visible, 21);
+}
+
+TEST(gridScan, inclusiveSums) {
+  auto const grid = AoC::numericGrid<uint_fast8_t>::fromString("123\n"
+                                                               "456\n");
+  auto const sums = AoC::scanDirections(grid, 0u, [](unsigned acc, auto v) { return acc + v; }, true);
+  EXPECT_EQ(sums.fromLeft[1][2], 15);
+  EXPECT_EQ(sums.fromRight[0][0], 6);
+  EXPECT_EQ(sums.fromTop[1][1], 7);
+  EXPECT_EQ(sums.fromTop[0][1], 2);
+  EXPECT_EQ(sums.fromBottom[0][2], 9);
+  EXPECT_EQ(sums.fromBottom[1][2], 6);
+}
@@ -0,0 +1,119 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "inputSource.h"
+#include "numericGrid.h"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+TEST(inputSource, viewStream) {
+  std::string const data = "123\n456\n";
+  AoC::ViewStreamBuf buf{data};
+  std::istream in{&buf};
+
+  AoC::numericGrid<uint_fast8_t> grid;
+  in >> grid;
+  EXPECT_EQ(grid.rows(), 2);
+  EXPECT_EQ((grid[std::pair{2, 1}]), 6);
+
+  in.clear();
+  in.seekg(4);
+  EXPECT_EQ(in.tellg(), 4);
+  EXPECT_EQ(in.get(), '4');
+  in.seekg(-2, std::ios_base::end);
+  EXPECT_EQ(in.get(), '6');
+}
+
+TEST(inputSource, file) {
+  auto const filename = std::filesystem::temp_directory_path() / "inputSource-file.txt";
+  {
+    std::ofstream out{filename};
+    out << "111\n222\n";
+  }
+  {
+    AoC::InputSource input{filename};
+    EXPECT_TRUE(input.mapped());
+    EXPECT_EQ(input.view(), "111\n222\n");
+    std::string line;
+    std::getline(input.stream(), line);
+    EXPECT_EQ(line, "111");
+  }
+  std::filesystem::remove(filename);
+
+  EXPECT_THROW(AoC::InputSource{"/nonexistent/input.txt"}, std::system_error);
+}
+
+TEST(inputSource, stdinOffset) {
+  auto const filename = std::filesystem::temp_directory_path() / "inputSource-stdin.txt";
+  std::string data(3 * 4096 + 100, 'x');
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  {
+    std::ofstream out{filename};
+    out << data;
+  }
+
+  // stdin redirected from a file, that was partly consumed already
+  int const saved = dup(STDIN_FILENO);
+  for (off_t offset : {0, 7, 4096, 5000}) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(lseek(fd, offset, SEEK_SET), offset);
+    ASSERT_EQ(dup2(fd, STDIN_FILENO), STDIN_FILENO);
+    close(fd);
+
+    AoC::InputSource input{"-"};
+    EXPECT_TRUE(input.mapped());
+    EXPECT_EQ(input.view(), std::string_view{data}.substr(static_cast<std::size_t>(offset)));
+  }
+  dup2(saved, STDIN_FILENO);
+  close(saved);
+  std::filesystem::remove(filename);
+}
+
+TEST(inputSource, pipe) {
+  // larger than one block, to see the reads continue
+  std::string data(2 * AoC::FdStreamBuf::BlockSize + 17, 'x');
+  for (auto asView : {false, true}) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::thread writer{[&] {
+      std::size_t done = 0;
+      while (done < data.size())
+        done += static_cast<std::size_t>(write(fds[1], data.data() + done, data.size() - done));
+      close(fds[1]);
+    }};
+
+    AoC::InputSource input{"/dev/fd/" + std::to_string(fds[0])};
+    EXPECT_FALSE(input.mapped());
+    if (asView) {
+      EXPECT_EQ(input.view(), data);
+    } else {
+      std::string read{std::istreambuf_iterator<char>{input.stream()}, {}};
+      EXPECT_EQ(read, data);
+    }
+    writer.join();
+    close(fds[0]);
+  }
+}
@@ -0,0 +1,95 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "nibbleGrid.h"
+#include <gtest/gtest.h>
+
+namespace {
+// 3x7 cells, so the last word is only partially used, values 0..15 and 0..4
+AoC::nibbleGrid ramp() {
+  AoC::nibbleGrid grid{3, 7};
+  for (std::size_t i = 0; i < grid.size(); ++i)
+    grid[{i % 7, i / 7}] = static_cast<std::uint8_t>(i % 16);
+  return grid;
+}
+
+uint8_t at(const AoC::nibbleGrid &grid, std::size_t i) { return grid[std::pair{i % 7, i / 7}]; }
+} // namespace
+
+TEST(nibbleGrid, access) {
+  auto grid = AoC::nibbleGrid::fromString("12345\n"
+                                          "67890\n");
+  EXPECT_EQ(grid.rows(), 2);
+  EXPECT_EQ(grid.columns(), 5);
+  EXPECT_EQ(grid.words().size(), 1);
+  EXPECT_EQ((grid[std::pair{2, 1}]), 8);
+
+  grid[{2, 1}] = 7;
+  grid[{3, 1}] = grid[{0, 0}];
+  EXPECT_EQ((grid[std::pair{2, 1}]), 7);
+  EXPECT_EQ((grid[std::pair{3, 1}]), 1);
+  EXPECT_EQ((grid[std::pair{4, 1}]), 0);
+
+  auto bytes = grid.toGrid();
+  EXPECT_EQ(bytes[1][2], 7);
+  EXPECT_EQ(AoC::nibbleGrid{bytes}, grid);
+}
+
+TEST(nibbleGrid, arithmetic) {
+  auto grid = ramp();
+  grid.add(7);
+  for (std::size_t i = 0; i < grid.size(); ++i)
+    EXPECT_EQ(at(grid, i), (i % 16 + 7) % 16) << i;
+  grid.sub(7);
+  EXPECT_EQ(grid, ramp());
+
+  grid.addSaturate(7);
+  for (std::size_t i = 0; i < grid.size(); ++i)
+    EXPECT_EQ(at(grid, i), std::min<std::size_t>(i % 16 + 7, 15)) << i;
+
+  grid = ramp();
+  grid.subSaturate(5);
+  for (std::size_t i = 0; i < grid.size(); ++i)
+    EXPECT_EQ(at(grid, i), i % 16 < 5 ? 0 : i % 16 - 5) << i;
+
+  // the unused lanes stay clear
+  grid.fill(15);
+  EXPECT_EQ(grid.words()[1], 0xfffffULL);
+}
+
+TEST(nibbleGrid, count) {
+  auto grid = ramp();
+  EXPECT_EQ(grid.count(0), 2);
+  EXPECT_EQ(grid.count(3), 2);
+  EXPECT_EQ(grid.count(15), 1);
+  EXPECT_EQ(grid.countAtLeast(0), 21);
+  EXPECT_EQ(grid.countAtLeast(4), 12 + 1);
+  EXPECT_EQ(grid.countAtLeast(15), 1);
+
+  auto mask = grid.atLeast(10);
+  EXPECT_EQ(mask.count(), 6);
+  EXPECT_TRUE(mask.test(3, 1));
+  EXPECT_FALSE(mask.test(2, 1));
+  EXPECT_EQ(grid.atLeast(0).count(), 21);
+
+  auto other = grid;
+  other ^= grid;
+  EXPECT_EQ(other.count(0), 21);
+  EXPECT_THROW(other &= AoC::nibbleGrid(7, 3), std::invalid_argument);
+}
@@ -18,6 +18,9 @@
 */
 
 #include "numericGrid.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 
 TEST(numericGrid, default) {
@@ -39,4 +42,78 @@ TEST(numericGrid, default) {
   auto v = grid.column(0);
   std::ranges::copy(v,std::back_inserter(tmp));
   EXPECT_EQ(tmp,(std::vector<uint_fast8_t>{1,2,3,4}));
-}
\ No newline at end of file
+}
+
+TEST(numericGrid, flatLayout) {
+  static const char *test_data = "123\n"
+                                 "456\n"
+                                 "789\n";
+
+  AoC::numericGrid<uint_fast8_t> grid;
+  std::istringstream s{test_data};
+  s >> grid;
+  EXPECT_EQ(grid.rows(), 3);
+  EXPECT_EQ(grid.columns(), 3);
+
+  // rows are spans into the shared buffer
+  auto row = grid[1];
+  EXPECT_EQ(row.size(), 3);
+  EXPECT_EQ(row.data(), grid.data() + 3);
+  EXPECT_EQ((grid[std::pair{2, 1}]), 6);
+
+  // the flat iterator is contiguous
+  auto it = grid.begin();
+  EXPECT_EQ(it[4], 5);
+  EXPECT_EQ(std::to_address(it + 8), grid.data() + 8);
+  EXPECT_EQ(grid.end() - grid.begin(), 9);
+  EXPECT_EQ(std::ranges::max(grid), 9);
+
+  // column views stride over the rows
+  auto col = grid.column(2);
+  EXPECT_EQ(col.end() - col.begin(), 3);
+  EXPECT_EQ(col.begin()[2], 9);
+  std::ranges::for_each(col, [](auto &v) { v = 0; });
+  EXPECT_EQ((grid[std::pair{2, 0}]), 0);
+  EXPECT_EQ((grid[std::pair{1, 0}]), 2);
+}
+
+TEST(numericGrid, raggedInput) {
+  AoC::numericGrid<uint_fast8_t> grid;
+  std::istringstream s{"123\n45\n"};
+  s >> grid;
+  EXPECT_TRUE(s.fail());
+  EXPECT_EQ(grid.rows(), 1);
+}
+
+TEST(numericGrid, fromString) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString("123\r\n456\n\n789");
+  EXPECT_EQ(grid.rows(), 3);
+  EXPECT_EQ(grid.columns(), 3);
+  EXPECT_TRUE(std::ranges::equal(grid, std::vector<uint_fast8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  EXPECT_THROW(AoC::numericGrid<uint_fast8_t>::fromString("123\n45\n"), std::invalid_argument);
+}
+
+TEST(numericGrid, crlf) {
+  std::string const input = "123\r\n456\r\n\r\n789\r\n";
+  AoC::numericGrid<uint_fast8_t> streamed;
+  std::istringstream s{input};
+  s >> streamed;
+  EXPECT_FALSE(s.bad());
+  EXPECT_EQ(streamed.columns(), 3);
+  EXPECT_TRUE(std::ranges::equal(streamed, AoC::numericGrid<uint_fast8_t>::fromString(input)));
+}
+
+TEST(numericGrid, fromFile) {
+  auto const filename = std::filesystem::temp_directory_path() / "numericGrid-fromFile.txt";
+  {
+    std::ofstream out{filename};
+    out << "111\n222\n";
+  }
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromFile(filename);
+  std::filesystem::remove(filename);
+  EXPECT_EQ(grid.size(), 6);
+  EXPECT_EQ((grid[std::pair{2, 1}]), 2);
+
+  EXPECT_THROW(AoC::numericGrid<uint_fast8_t>::fromFile("/nonexistent/grid.txt"), std::system_error);
+}
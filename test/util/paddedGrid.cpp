@@ -0,0 +1,111 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "paddedGrid.h"
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+TEST(numericGrid, neighbours) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString("123\n"
+                                                         "456\n"
+                                                         "789\n");
+
+  std::vector<std::pair<std::size_t, std::size_t>> pos;
+  std::ranges::copy(grid.neighbours4({0, 0}), std::back_inserter(pos));
+  EXPECT_EQ(pos, (std::vector<std::pair<std::size_t, std::size_t>>{{1, 0}, {0, 1}}));
+
+  pos.clear();
+  std::ranges::copy(grid.neighbours8({1, 1}), std::back_inserter(pos));
+  EXPECT_EQ(pos.size(), 8);
+
+  pos.clear();
+  std::ranges::copy(grid.neighbours8({2, 2}), std::back_inserter(pos));
+  EXPECT_EQ(pos, (std::vector<std::pair<std::size_t, std::size_t>>{{1, 1}, {2, 1}, {1, 2}}));
+
+  // custom stencil: knight moves
+  static constexpr AoC::Stencil<2> knight{{{1, 2}, {2, 1}}};
+  int sum = 0;
+  for (auto p : grid.neighbours({0, 0}, knight))
+    sum += grid[p];
+  EXPECT_EQ(sum, 8 + 6);
+}
+
+TEST(paddedGrid, access) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString("12\n34\n");
+  AoC::paddedGrid<uint_fast8_t> padded{grid, 9};
+
+  EXPECT_EQ(padded.stride(), 4);
+  EXPECT_EQ((padded[{0, 0}]), 1);
+  EXPECT_EQ((padded[{1, 1}]), 4);
+  EXPECT_EQ((padded[{-1, -1}]), 9);
+  EXPECT_EQ((padded[{2, 1}]), 9);
+
+  int sum = 0;
+  padded.forEachNeighbour({0, 0}, AoC::stencil8, [&sum](auto v) { sum += v; });
+  EXPECT_EQ(sum, 5 * 9 + 2 + 3 + 4);
+
+  padded[{1, 0}] = 7;
+  auto back = padded.toGrid();
+  EXPECT_EQ(back.rows(), 2);
+  EXPECT_EQ((back[std::pair{1, 0}]), 7);
+}
+
+TEST(paddedGrid, apply) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString("010\n"
+                                                         "111\n"
+                                                         "010\n");
+  AoC::paddedGrid<uint_fast8_t> padded{grid, 0};
+
+  auto lit = padded.apply(AoC::stencil8, [](auto, const auto &n) { return std::accumulate(n.begin(), n.end(), 0); });
+  EXPECT_EQ(lit.rows(), 3);
+  EXPECT_EQ((lit[std::pair{1, 1}]), 4);
+  EXPECT_EQ((lit[std::pair{0, 0}]), 3);
+  EXPECT_EQ((lit[std::pair{1, 0}]), 3);
+
+  // low points: lower than all 4 neighbours, the border never wins
+  auto heights = AoC::numericGrid<uint_fast8_t>::fromString("919\n"
+                                                            "999\n"
+                                                            "990\n");
+  AoC::paddedGrid<uint_fast8_t> hp{heights, 10};
+  auto low = hp.apply(AoC::stencil4, [](auto c, const auto &n) { return static_cast<uint_fast8_t>(std::ranges::all_of(n, [c](auto v) { return c < v; })); });
+  EXPECT_EQ(low.count(1), 2);
+
+  // a bool rule produces a mask
+  auto mask = hp.apply(AoC::stencil4, [](auto c, const auto &n) { return std::ranges::all_of(n, [c](auto v) { return c < v; }); });
+  static_assert(std::is_same_v<decltype(mask), AoC::numericGrid<uint8_t>>);
+  EXPECT_EQ(mask.count(1), 2);
+  EXPECT_EQ((mask[std::pair{2, 2}]), 1);
+}
+
+TEST(paddedGrid, reach) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString("123\n456\n789\n");
+  static constexpr AoC::Stencil<2> far{{{-2, 0}, {2, 0}}};
+  auto sum = [](auto, const auto &n) { return n[0] + n[1]; };
+
+  AoC::paddedGrid<uint_fast8_t> narrow{grid};
+  EXPECT_THROW(narrow.apply(far, sum), std::invalid_argument);
+  EXPECT_DEBUG_DEATH(narrow.forEachNeighbour({0, 0}, far, [](auto) {}), "padding");
+
+  AoC::paddedGrid<uint_fast8_t> wide{grid, 0, 2};
+  auto out = wide.apply(far, sum);
+  EXPECT_EQ((out[std::pair{0, 1}]), 6);
+  EXPECT_EQ((out[std::pair{1, 1}]), 0);
+  EXPECT_EQ((out[std::pair{2, 2}]), 7);
+}
@@ -0,0 +1,85 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "parallel.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+TEST(parallel, everyIndexOnce) {
+  std::vector<int> hits(1000);
+  std::vector<std::size_t> perWorker(AoC::workerCount(hits.size(), 4));
+  AoC::parallelFor(
+      hits.size(),
+      [&](unsigned worker, std::size_t i) {
+        ++hits[i];
+        ++perWorker[worker];
+      },
+      4);
+  EXPECT_TRUE(std::ranges::all_of(hits, [](int h) { return h == 1; }));
+  EXPECT_EQ(std::accumulate(perWorker.begin(), perWorker.end(), std::size_t{0}), hits.size());
+}
+
+TEST(parallel, exceptions) {
+  EXPECT_THROW(AoC::parallelFor(
+                   100,
+                   [](unsigned, std::size_t i) {
+                     if (i == 42)
+                       throw std::runtime_error("42");
+                   },
+                   3),
+               std::runtime_error);
+  EXPECT_EQ(AoC::workerCount(2, 8), 2);
+  EXPECT_EQ(AoC::workerCount(0, 8), 1);
+}
+
+TEST(parallel, pool) {
+  AoC::WorkerPool pool{4};
+  EXPECT_EQ(pool.size(), 4);
+  for (int round = 0; round < 50; ++round) {
+    std::vector<int> hits(round * 7 + 1);
+    std::vector<std::size_t> perWorker(pool.size());
+    pool.parallelFor(hits.size(), [&](unsigned worker, std::size_t i) {
+      ++hits[i];
+      ++perWorker[worker];
+    });
+    EXPECT_TRUE(std::ranges::all_of(hits, [](int h) { return h == 1; }));
+    EXPECT_EQ(std::accumulate(perWorker.begin(), perWorker.end(), std::size_t{0}), hits.size());
+  }
+
+  EXPECT_THROW(pool.parallelFor(100,
+                                [](unsigned, std::size_t i) {
+                                  if (i == 42)
+                                    throw std::runtime_error("42");
+                                }),
+               std::runtime_error);
+
+  // the pool is still usable after an exception, and nested jobs run on the calling worker
+  std::atomic<std::size_t> inner{0};
+  pool.parallelFor(8, [&](unsigned, std::size_t) {
+    pool.parallelFor(10, [&](unsigned worker, std::size_t) {
+      EXPECT_EQ(worker, 0);
+      ++inner;
+    });
+  });
+  EXPECT_EQ(inner, 80);
+}
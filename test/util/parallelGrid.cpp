@@ -0,0 +1,73 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "parallelGrid.h"
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <string>
+
+namespace {
+// large enough for several blocks of rows
+AoC::numericGrid<uint32_t> ramp() {
+  AoC::numericGrid<uint32_t> grid{300, 200};
+  std::iota(grid.begin(), grid.end(), 0u);
+  return grid;
+}
+} // namespace
+
+TEST(parallelGrid, forEach) {
+  auto grid = ramp();
+  AoC::parallelForEach(grid, [](auto &v) { v *= 2; }, 4);
+  EXPECT_EQ((grid[std::pair{3, 2}]), 2 * (2 * 200 + 3));
+
+  AoC::parallelForEachRow(grid, [](auto row, auto y) { row[0] = static_cast<uint32_t>(y); }, 4);
+  EXPECT_EQ(grid[299][0], 299);
+  EXPECT_EQ(grid[299][1], 2 * (299 * 200 + 1));
+}
+
+TEST(parallelGrid, transform) {
+  auto const grid = ramp();
+  auto odd = AoC::parallelTransform(grid, [](auto v) -> uint8_t { return v % 2; }, 4);
+  static_assert(std::is_same_v<decltype(odd), AoC::numericGrid<uint8_t>>);
+  EXPECT_EQ(odd.rows(), 300);
+  EXPECT_EQ(odd.count(1), grid.size() / 2);
+
+  auto big = AoC::parallelTransform(grid, [](auto v) { return v > 3; }, 4);
+  static_assert(std::is_same_v<decltype(big), AoC::numericGrid<uint8_t>>);
+  EXPECT_EQ(big.count(0), 4);
+}
+
+TEST(parallelGrid, reduce) {
+  auto const grid = ramp();
+  auto const n = static_cast<uint64_t>(grid.size());
+  EXPECT_EQ(AoC::parallelReduce(grid, uint64_t{0}), n * (n - 1) / 2);
+  EXPECT_EQ(AoC::parallelReduce(grid, uint32_t{0}, [](uint32_t a, uint32_t b) { return std::max(a, b); }, 4), n - 1);
+  EXPECT_EQ(AoC::parallelCountIf(grid, [](auto v) { return v % 3 == 0; }, 4), n / 3);
+
+  // the order of the blocks is kept, even for an operation, that does not commute
+  EXPECT_EQ(AoC::parallelReduce(grid, uint32_t{0}, [](uint32_t, uint32_t b) { return b; }, 4), n - 1);
+  auto const digits = AoC::numericGrid<uint_fast8_t>::fromString("12\n34\n");
+  auto concat = AoC::parallelTransformReduce(
+      digits, std::string{">"}, std::plus<>{}, [](auto v) { return std::to_string(v); }, 4);
+  EXPECT_EQ(concat, ">1234");
+
+  AoC::numericGrid<uint32_t> empty;
+  EXPECT_EQ(AoC::parallelReduce(empty, uint32_t{7}), 7);
+}
@@ -0,0 +1,95 @@
+/*
+    Copyright (c) 2022 Thomas Berger <loki@loki.codes> All rights reserved.
+
+    This file is part of Lokis AoC C++ Utilities.
+
+    `AoC C++ Utilities` is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Foobar is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "propagator.h"
+#include <gtest/gtest.h>
+
+#include <functional>
+
+namespace {
+auto const heights = AoC::numericGrid<uint_fast8_t>::fromString("2199943210\n"
+                                                                "3987894921\n"
+                                                                "9856789892\n"
+                                                                "8767896789\n"
+                                                                "9899965678\n");
+}
+
+TEST(propagator, floodFill) {
+  AoC::Propagator propagator;
+  auto const notNine = [](auto v) { return v != 9; };
+  EXPECT_EQ(propagator.floodFill(heights, {0, 0}, AoC::stencil4, notNine), 3);
+  EXPECT_EQ(propagator.floodFill(heights, {9, 0}, AoC::stencil4, notNine), 9);
+  EXPECT_EQ(propagator.floodFill(heights, {2, 2}, AoC::stencil4, notNine), 14);
+
+  // climb at most one up
+  std::vector<std::size_t> distance(heights.size());
+  auto const reached = propagator.floodFill(
+      heights, {0, 0}, AoC::stencil4, [](auto from, auto to) { return to <= from + 1; },
+      [&](auto pos, auto d) { distance[pos.second * heights.columns() + pos.first] = d; });
+  EXPECT_EQ(reached, 3);
+  EXPECT_EQ(distance[1], 1);
+  EXPECT_EQ(distance[10], 1);
+  EXPECT_EQ(propagator.triggered().size(), 3);
+
+  EXPECT_THROW(propagator.floodFill(heights, {heights.columns(), 0}, AoC::stencil4, notNine), std::invalid_argument);
+  EXPECT_THROW(propagator.floodFill(heights, {0, heights.rows()}, AoC::stencil4, notNine), std::invalid_argument);
+  EXPECT_THROW(propagator.floodFill(AoC::numericGrid<uint_fast8_t>{}, {0, 0}, AoC::stencil4, notNine), std::invalid_argument);
+}
+
+TEST(propagator, label) {
+  AoC::Propagator propagator{heights.size()};
+  auto basins = propagator.label(heights, AoC::stencil4, [](auto v) { return v != 9; });
+  ASSERT_EQ(basins.count(), 4);
+  EXPECT_EQ(basins.sizes, (std::vector<std::size_t>{3, 9, 14, 9}));
+  EXPECT_EQ(basins.labels[0][0], 0);
+  EXPECT_EQ(basins.labels[0][9], 1);
+  EXPECT_EQ(basins.labels[0][2], AoC::Components::none);
+
+  auto regions = propagator.label(AoC::numericGrid<uint_fast8_t>::fromString("1122\n"
+                                                                             "1322\n"
+                                                                             "1111\n"),
+                                  AoC::stencil4, std::equal_to<>{});
+  EXPECT_EQ(regions.sizes, (std::vector<std::size_t>{7, 4, 1}));
+  EXPECT_EQ(regions.labels[1][1], 2);
+}
+
+TEST(propagator, cascade) {
+  auto grid = AoC::numericGrid<uint_fast8_t>::fromString("5483143223\n"
+                                                         "2745854711\n"
+                                                         "5264556173\n"
+                                                         "6141336146\n"
+                                                         "6357385478\n"
+                                                         "4167524645\n"
+                                                         "2176841721\n"
+                                                         "6882881134\n"
+                                                         "4846848554\n"
+                                                         "5283751526\n");
+  AoC::Propagator propagator{grid.size()};
+  std::size_t flashes = 0;
+  for (int step = 1; step <= 100; ++step) {
+    grid.add(1);
+    flashes += propagator.cascade(grid, AoC::stencil8, uint_fast8_t{10});
+    for (auto idx : propagator.triggered())
+      grid.data()[idx] = 0;
+    if (step == 10) {
+      EXPECT_EQ(flashes, 204);
+    }
+  }
+  EXPECT_EQ(flashes, 1656);
+}